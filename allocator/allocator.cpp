@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <sstream>
 #include "not_implemented.h"
 #include "allocator.h"
@@ -121,10 +122,11 @@ void *allocator::get_occupied_block_next_block_address(
 }
 
 void allocator::dump_occupied_block_before_deallocate(
-    void const *current_block_address,
-    logger *logger) const
+    [[maybe_unused]] void const *current_block_address,
+    [[maybe_unused]] logger *logger) const
 {
-    if (logger == nullptr)
+#ifndef LOGGER_HOLDER_DISABLE_LOGGING
+    if (logger == nullptr || !logger->is_enabled(logger::severity::trace))
     {
         return;
     }
@@ -135,7 +137,7 @@ void allocator::dump_occupied_block_before_deallocate(
     auto const *dump_iterator = reinterpret_cast<unsigned char const *>(reinterpret_cast<size_t const *>(current_block_address) + 1);
     std::string result;
 
-    for (auto i = 0; i < current_block_size; i++)
+    for (size_t i = 0; i < current_block_size; i++)
     {
         result += std::to_string(static_cast<unsigned short>(*dump_iterator++));
 
@@ -147,6 +149,7 @@ void allocator::dump_occupied_block_before_deallocate(
 
     logger->trace("Memory at " + address_to_hex(current_block_address) + " = [" + result + "]")
         ->trace("Method memory::dump_occupied_block_before_deallocate(void * const current_block_address, logger *logger) const execution finished");
+#endif
 }
 
 void allocator::dump_trusted_memory_blocks_state() const
@@ -154,6 +157,64 @@ void allocator::dump_trusted_memory_blocks_state() const
     throw not_implemented("void memory::dump_trusted_memory_blocks_state() const");
 }
 
+void *allocator::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    try
+    {
+        return allocate(requested_block_size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *allocator::try_reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    try
+    {
+        return reallocate(block_to_reallocate_address, new_block_size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void allocator::allocate_batch(
+    size_t requested_block_size,
+    size_t blocks_count,
+    void **allocated_blocks_addresses)
+{
+    size_t allocated_blocks_count = 0;
+
+    try
+    {
+        for (; allocated_blocks_count < blocks_count; allocated_blocks_count++)
+        {
+            allocated_blocks_addresses[allocated_blocks_count] = allocate(requested_block_size);
+        }
+    }
+    catch (...)
+    {
+        deallocate_batch(allocated_blocks_addresses, allocated_blocks_count);
+        throw;
+    }
+}
+
+void allocator::deallocate_batch(
+    void **blocks_to_deallocate_addresses,
+    size_t blocks_count)
+{
+    for (size_t i = 0; i < blocks_count; i++)
+    {
+        deallocate(blocks_to_deallocate_addresses[i]);
+    }
+}
+
 void *allocator::operator+=(
     size_t requested_block_size)
 {
@@ -178,3 +239,26 @@ std::string allocator::address_to_hex(
 {
     return std::string { (std::stringstream() << pointer).str() };
 }
+
+bool allocator::is_alignment_valid(
+    size_t alignment) noexcept
+{
+    return alignment != 0 && (alignment & (alignment - 1)) == 0;
+}
+
+size_t allocator::get_aligned_block_offset(
+    void const *block_address,
+    size_t block_header_size,
+    size_t alignment,
+    size_t minimal_offset) noexcept
+{
+    auto const block_data_address = reinterpret_cast<uintptr_t>(block_address) + block_header_size;
+    auto offset = ((block_data_address + alignment - 1) & ~(alignment - 1)) - block_data_address;
+
+    if (offset != 0 && offset < minimal_offset)
+    {
+        offset += (minimal_offset - offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    return offset;
+}
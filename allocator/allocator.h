@@ -122,6 +122,32 @@ public:
         void **block_to_reallocate_address_address,
         size_t new_block_size) = 0;
 
+    // allocated block data is placed at address multiple of alignment, which should be a power of 2
+    [[nodiscard]] virtual void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) = 0;
+
+    // report exhausted memory by nullptr instead of exception, block to reallocate is left untouched then;
+    // exceptions of the throwing methods are caught unless allocator provides non-throwing path natively
+    [[nodiscard]] virtual void *try_allocate(
+        size_t requested_block_size) noexcept;
+
+    [[nodiscard]] virtual void *try_reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) noexcept;
+
+    // allocates either all of blocks_count blocks of the same size or none of them;
+    // blocks are allocated one by one unless allocator carves them natively
+    virtual void allocate_batch(
+        size_t requested_block_size,
+        size_t blocks_count,
+        void **allocated_blocks_addresses);
+
+    // blocks addresses may be reordered by allocator releasing blocks in address order
+    virtual void deallocate_batch(
+        void **blocks_to_deallocate_addresses,
+        size_t blocks_count);
+
 public:
 
     void *operator+=(
@@ -141,6 +167,17 @@ protected:
     [[nodiscard]] static std::string address_to_hex(
         void const *pointer) noexcept;
 
+    [[nodiscard]] static bool is_alignment_valid(
+        size_t alignment) noexcept;
+
+    // offset from the block address to the block whose data, placed after header of given size, is aligned;
+    // non-zero offset is never LT minimal offset, so the space skipped still fits an available block
+    [[nodiscard]] static size_t get_aligned_block_offset(
+        void const *block_address,
+        size_t block_header_size,
+        size_t alignment,
+        size_t minimal_offset) noexcept;
+
 };
 
 #endif // DATA_STRUCTURES_CPP_MEMORY_H
@@ -0,0 +1,390 @@
+#include <cstring>
+#include <mutex>
+#include "allocator_arena.h"
+
+allocator_arena::allocator_arena(
+    size_t chunk_size,
+    allocator *outer_allocator,
+    logger *log)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested chunk size: " + std::to_string(chunk_size) + " bytes");
+    }
+
+    chunk_size = (chunk_size + block_alignment - 1) / block_alignment * block_alignment;
+
+    auto const allocator_service_block_size = get_allocator_service_block_size();
+    auto const chunk_service_block_size = get_chunk_service_block_size();
+
+    _trusted_memory = outer_allocator == nullptr
+        ? ::operator new(allocator_service_block_size + chunk_service_block_size + chunk_size)
+        : outer_allocator->allocate(allocator_service_block_size + chunk_service_block_size + chunk_size);
+
+    auto * const chunk_size_space = reinterpret_cast<size_t *>(_trusted_memory);
+    *chunk_size_space = chunk_size;
+
+    auto * const outer_allocator_pointer_space = reinterpret_cast<allocator **>(chunk_size_space + 1);
+    *outer_allocator_pointer_space = outer_allocator;
+
+    auto * const logger_pointer_space = reinterpret_cast<logger **>(outer_allocator_pointer_space + 1);
+    *logger_pointer_space = log;
+
+    new (get_lock()) spinlock();
+
+    // the first chunk is embedded into trusted memory and is never released until destruction
+    auto * const first_chunk = get_first_chunk_address();
+    *reinterpret_cast<void **>(first_chunk) = nullptr;
+    *reinterpret_cast<size_t *>(reinterpret_cast<void **>(first_chunk) + 1) = chunk_size;
+
+    *get_current_chunk_address_address() = first_chunk;
+    *get_top_address_address() = get_chunk_data_address(first_chunk);
+    *get_end_address_address() = get_chunk_data_address(first_chunk) + chunk_size;
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_arena::~allocator_arena() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    release_chunks_newer_than(get_first_chunk_address());
+    deallocate_with_guard(_trusted_memory);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_arena::get_trusted_memory_size() const noexcept
+{
+    return *reinterpret_cast<size_t *>(_trusted_memory);
+}
+
+size_t allocator_arena::get_allocator_service_block_size() const noexcept
+{
+    auto const chunk_size_size = sizeof(size_t);
+    auto const outer_allocator_pointer_size = sizeof(allocator *);
+    auto const logger_pointer_size = sizeof(logger *);
+    auto const lock_size = sizeof(spinlock);
+    auto const current_chunk_pointer_size = sizeof(void *);
+    auto const top_pointer_size = sizeof(unsigned char *);
+    auto const end_pointer_size = sizeof(unsigned char *);
+
+    return chunk_size_size + outer_allocator_pointer_size + logger_pointer_size + lock_size + current_chunk_pointer_size + top_pointer_size + end_pointer_size;
+}
+
+size_t allocator_arena::get_occupied_block_service_block_size() const noexcept
+{
+    return sizeof(size_t);
+}
+
+size_t allocator_arena::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address);
+}
+
+size_t allocator_arena::get_chunk_service_block_size() const noexcept
+{
+    auto const previous_chunk_pointer_size = sizeof(void *);
+    auto const chunk_data_size_size = sizeof(size_t);
+
+    return previous_chunk_pointer_size + chunk_data_size_size;
+}
+
+void *allocator_arena::get_first_chunk_address() const noexcept
+{
+    return reinterpret_cast<unsigned char *>(_trusted_memory) + get_allocator_service_block_size();
+}
+
+spinlock *allocator_arena::get_lock() const noexcept
+{
+    return reinterpret_cast<spinlock *>(reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1) + 1);
+}
+
+void **allocator_arena::get_current_chunk_address_address() const noexcept
+{
+    return reinterpret_cast<void **>(get_lock() + 1);
+}
+
+unsigned char **allocator_arena::get_top_address_address() const noexcept
+{
+    return reinterpret_cast<unsigned char **>(get_current_chunk_address_address() + 1);
+}
+
+unsigned char **allocator_arena::get_end_address_address() const noexcept
+{
+    return get_top_address_address() + 1;
+}
+
+void *allocator_arena::get_chunk_previous_chunk_address(
+    void const *chunk_address) noexcept
+{
+    return *reinterpret_cast<void * const *>(chunk_address);
+}
+
+size_t allocator_arena::get_chunk_data_size(
+    void const *chunk_address) noexcept
+{
+    return *reinterpret_cast<size_t const *>(reinterpret_cast<void * const *>(chunk_address) + 1);
+}
+
+unsigned char *allocator_arena::get_chunk_data_address(
+    void const *chunk_address) const noexcept
+{
+    return const_cast<unsigned char *>(reinterpret_cast<unsigned char const *>(chunk_address)) + get_chunk_service_block_size();
+}
+
+void allocator_arena::allocate_chunk(
+    size_t requested_data_size)
+{
+    auto const chunk_size = get_trusted_memory_size();
+    auto const chunk_data_size = requested_data_size > chunk_size
+        ? requested_data_size
+        : chunk_size;
+    auto const chunk_service_block_size = get_chunk_service_block_size();
+
+    this->debug_with_guard([&] { return "Allocating chunk of " + std::to_string(chunk_service_block_size + chunk_data_size) + " bytes"; });
+
+    auto * const chunk = allocate_with_guard(chunk_service_block_size + chunk_data_size);
+
+    auto * const current_chunk_address_address = get_current_chunk_address_address();
+    *reinterpret_cast<void **>(chunk) = *current_chunk_address_address;
+    *reinterpret_cast<size_t *>(reinterpret_cast<void **>(chunk) + 1) = chunk_data_size;
+
+    // the rest of the previous chunk is abandoned until reset or rewind
+    *current_chunk_address_address = chunk;
+    *get_top_address_address() = get_chunk_data_address(chunk);
+    *get_end_address_address() = get_chunk_data_address(chunk) + chunk_data_size;
+}
+
+void allocator_arena::release_chunks_newer_than(
+    void *chunk_address)
+{
+    auto * const current_chunk_address_address = get_current_chunk_address_address();
+
+    while (*current_chunk_address_address != chunk_address)
+    {
+        auto * const chunk_to_release = *current_chunk_address_address;
+        *current_chunk_address_address = get_chunk_previous_chunk_address(chunk_to_release);
+        deallocate_with_guard(chunk_to_release);
+    }
+
+    *get_end_address_address() = get_chunk_data_address(chunk_address) + get_chunk_data_size(chunk_address);
+}
+
+void *allocator_arena::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    auto const block_data_size = (requested_block_size + block_alignment - 1) / block_alignment * block_alignment;
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const top_address_address = get_top_address_address();
+    auto aligned_block_offset = get_aligned_block_offset(*top_address_address, occupied_block_service_block_size, alignment, 0);
+
+    // padding before an aligned block is abandoned like the rest of a chunk, reset or rewind reclaim it
+    if (static_cast<size_t>(*get_end_address_address() - *top_address_address) < aligned_block_offset + occupied_block_service_block_size + block_data_size)
+    {
+        allocate_chunk(occupied_block_service_block_size + block_data_size + (alignment > block_alignment ? alignment : 0));
+        aligned_block_offset = get_aligned_block_offset(*top_address_address, occupied_block_service_block_size, alignment, 0);
+    }
+
+    auto * const allocated_block = *top_address_address + aligned_block_offset;
+    *top_address_address = allocated_block + occupied_block_service_block_size + block_data_size;
+    *reinterpret_cast<size_t *>(allocated_block) = block_data_size;
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); });
+
+    return reinterpret_cast<size_t *>(allocated_block) + 1;
+}
+
+void *allocator_arena::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto * const allocated_block = allocate_block(requested_block_size, block_alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    return allocated_block;
+}
+
+void *allocator_arena::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
+    {
+        auto const warning_message = "alignment should be a power of 2";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate_block(requested_block_size, alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    return allocated_block;
+}
+
+void allocator_arena::deallocate(
+    void *)
+{
+    // arena blocks are released all at once by reset, rewind or destruction
+}
+
+void *allocator_arena::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution started"; });
+
+    auto * const block_address = reinterpret_cast<size_t *>(block_to_reallocate_address) - 1;
+
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    auto const block_data_size = get_occupied_block_size(block_address);
+    auto const new_block_data_size = (new_block_size + block_alignment - 1) / block_alignment * block_alignment;
+
+    auto * const top_address_address = get_top_address_address();
+    auto * const block_data_address = reinterpret_cast<unsigned char *>(block_to_reallocate_address);
+
+    // the topmost block grows or shrinks in place
+    if (block_data_address + block_data_size == *top_address_address &&
+        static_cast<size_t>(*get_end_address_address() - block_data_address) >= new_block_data_size)
+    {
+        *block_address = new_block_data_size;
+        *top_address_address = block_data_address + new_block_data_size;
+
+        this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+        return block_to_reallocate_address;
+    }
+
+    lock.unlock();
+
+    if (new_block_data_size <= block_data_size)
+    {
+        this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+        return block_to_reallocate_address;
+    }
+
+    auto * const new_block_to_reallocate_address = allocate(new_block_size);
+    memcpy(new_block_to_reallocate_address, block_to_reallocate_address, block_data_size);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+    return new_block_to_reallocate_address;
+}
+
+bool allocator_arena::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    try {
+        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
+        return true;
+    }
+    catch (std::exception const &ex)
+    {
+        this->warning_with_guard(ex.what());
+        return false;
+    }
+}
+
+void allocator_arena::reset()
+{
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::reset()` execution started"; });
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const first_chunk = get_first_chunk_address();
+    release_chunks_newer_than(first_chunk);
+    *get_top_address_address() = get_chunk_data_address(first_chunk);
+
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::reset()` execution finished"; });
+}
+
+void *allocator_arena::mark() const noexcept
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    return *get_top_address_address();
+}
+
+void allocator_arena::rewind(
+    void *checkpoint)
+{
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::rewind(void *checkpoint)` execution started"; });
+
+    auto * const checkpoint_address = reinterpret_cast<unsigned char *>(checkpoint);
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const top_address = *get_top_address_address();
+    void *chunk = *get_current_chunk_address_address();
+
+    // checkpoint of the current chunk can't be placed after the top
+    if (checkpoint_address >= get_chunk_data_address(chunk) && checkpoint_address > top_address &&
+        checkpoint_address <= get_chunk_data_address(chunk) + get_chunk_data_size(chunk))
+    {
+        chunk = nullptr;
+    }
+
+    while (chunk != nullptr &&
+        (checkpoint_address < get_chunk_data_address(chunk) ||
+         checkpoint_address > get_chunk_data_address(chunk) + get_chunk_data_size(chunk)))
+    {
+        chunk = get_chunk_previous_chunk_address(chunk);
+    }
+
+    if (chunk == nullptr)
+    {
+        auto const warning_message = "checkpoint does not belong to current allocator state";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void " + get_typename() + "::rewind(void *checkpoint)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    release_chunks_newer_than(chunk);
+    *get_top_address_address() = checkpoint_address;
+
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::rewind(void *checkpoint)` execution finished"; });
+}
+
+logger *allocator_arena::get_logger() const noexcept
+{
+    return *reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1);
+}
+
+std::string allocator_arena::get_typename() const noexcept
+{
+    return "allocator_arena";
+}
+
+allocator *allocator_arena::get_allocator() const noexcept
+{
+    return *reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1);
+}
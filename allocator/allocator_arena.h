@@ -0,0 +1,128 @@
+#ifndef DATA_STRUCTURES_CPP_MEMORY_WITH_ARENA_H
+#define DATA_STRUCTURES_CPP_MEMORY_WITH_ARENA_H
+
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "allocator_holder.h"
+#include "spinlock.h"
+
+class allocator_arena final:
+    public allocator,
+    protected logger_holder,
+    protected typename_holder,
+    protected allocator_holder
+{
+
+private:
+
+    void *_trusted_memory;
+
+private:
+
+    static constexpr size_t block_alignment = sizeof(size_t);
+
+public:
+
+    explicit allocator_arena(
+        size_t chunk_size,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr);
+
+    allocator_arena(
+        allocator_arena const &other) = delete;
+
+    allocator_arena &operator=(
+        allocator_arena const &other) = delete;
+
+    ~allocator_arena() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_trusted_memory_size() const noexcept override;
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    size_t get_occupied_block_size(
+        void const *current_block_address) const override;
+
+private:
+
+    [[nodiscard]] size_t get_chunk_service_block_size() const noexcept;
+
+    [[nodiscard]] spinlock *get_lock() const noexcept;
+
+    [[nodiscard]] void *get_first_chunk_address() const noexcept;
+
+    [[nodiscard]] void **get_current_chunk_address_address() const noexcept;
+
+    [[nodiscard]] unsigned char **get_top_address_address() const noexcept;
+
+    [[nodiscard]] unsigned char **get_end_address_address() const noexcept;
+
+    static void *get_chunk_previous_chunk_address(
+        void const *chunk_address) noexcept;
+
+    static size_t get_chunk_data_size(
+        void const *chunk_address) noexcept;
+
+    [[nodiscard]] unsigned char *get_chunk_data_address(
+        void const *chunk_address) const noexcept;
+
+    void allocate_chunk(
+        size_t requested_data_size);
+
+    void release_chunks_newer_than(
+        void *chunk_address);
+
+    [[nodiscard]] void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment);
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+public:
+
+    void reset();
+
+    [[nodiscard]] void *mark() const noexcept;
+
+    void rewind(
+        void *checkpoint);
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+private:
+
+    [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_MEMORY_WITH_ARENA_H
@@ -1,10 +1,12 @@
+#include <cstring>
+#include <new>
 #include "allocator_base.h"
 
 allocator_base::allocator_base(
     size_t memory_size,
     allocator* outer_allocator,
     logger* log,
-    allocator_fit_allocation::allocation_mode allocation_mode) : outer_allocator_(outer_allocator)
+    allocator_fit_allocation::allocation_mode allocation_mode)
 {
     auto got_typename = get_typename();
 
@@ -31,23 +33,17 @@ allocator_base::allocator_base(
     auto const allocator_service_block_size = get_allocator_service_block_size();
 
     _trusted_memory = outer_allocator == nullptr
-        ? ::operator new(memory_size + allocator_service_block_size)
-        : outer_allocator->allocate(memory_size + allocator_service_block_size);
+        ? ::operator new(memory_size + allocator_service_block_size, std::align_val_t(cache_line_size))
+        : outer_allocator->allocate_aligned(memory_size + allocator_service_block_size, cache_line_size);
 
-    auto* const memory_size_space = reinterpret_cast<size_t*>(_trusted_memory);
-    *memory_size_space = memory_size;
+    auto* const header = new (_trusted_memory) trusted_memory_header();
+    header->allocation_mode = allocation_mode;
+    header->logger = log;
+    header->memory_size = memory_size;
+    header->outer_allocator = outer_allocator;
 
-    auto* const outer_allocator_pointer_space = reinterpret_cast<allocator**>(memory_size_space + 1);
-    *outer_allocator_pointer_space = outer_allocator;
-
-    auto* const logger_pointer_space = reinterpret_cast<logger**>(outer_allocator_pointer_space + 1);
-    *logger_pointer_space = log;
-
-    auto* const allocation_mode_space = reinterpret_cast<allocator_fit_allocation::allocation_mode*>(logger_pointer_space + 1);
-    *allocation_mode_space = allocation_mode;
-
-    auto* const first_available_block_pointer_space = reinterpret_cast<void**>(allocation_mode_space + 1);
-    *first_available_block_pointer_space = reinterpret_cast<void*>(first_available_block_pointer_space + 1);
+    auto* const first_available_block_pointer_space = get_first_available_block_address_address();
+    *first_available_block_pointer_space = reinterpret_cast<unsigned char*>(_trusted_memory) + allocator_service_block_size;
 
     auto* const first_available_block_size_space = reinterpret_cast<size_t*>(*first_available_block_pointer_space);
     *first_available_block_size_space = memory_size;
@@ -65,14 +61,7 @@ allocator_base::~allocator_base() noexcept
 
     auto const* const logger = get_logger();
 
-    if (outer_allocator_ == nullptr)
-    {
-        ::operator delete(_trusted_memory);
-    }
-    else
-    {
-        outer_allocator_->deallocate(_trusted_memory);
-    }
+    deallocate_aligned_with_guard(_trusted_memory, cache_line_size);
 
     if (logger != nullptr)
     {
@@ -85,23 +74,17 @@ allocator_base::~allocator_base() noexcept
 
 size_t allocator_base::get_trusted_memory_size() const noexcept
 {
-    return *reinterpret_cast<size_t*>(_trusted_memory);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->memory_size;
 }
 
 allocator_fit_allocation::allocation_mode allocator_base::get_allocation_mode() const noexcept
 {
-    return *reinterpret_cast<allocator_fit_allocation::allocation_mode*>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*));
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->allocation_mode;
 }
 
 size_t allocator_base::get_allocator_service_block_size() const noexcept
 {
-    auto const memory_size_size = sizeof(size_t);
-    auto const outer_allocator_pointer_size = sizeof(allocator*);
-    auto const logger_pointer_size = sizeof(logger*);
-    auto const allocation_mode_size = sizeof(allocator_fit_allocation::allocation_mode);
-    auto const first_available_block_pointer_size = sizeof(void*);
-
-    return memory_size_size + outer_allocator_pointer_size + logger_pointer_size + allocation_mode_size + first_available_block_pointer_size;
+    return first_block_offset;
 }
 
 size_t allocator_base::get_available_block_service_block_size() const noexcept
@@ -114,14 +97,15 @@ size_t allocator_base::get_available_block_service_block_size() const noexcept
 
 size_t allocator_base::get_occupied_block_service_block_size() const noexcept
 {
+    auto const origin_pointer_size = sizeof(void*);
     auto const current_block_size = sizeof(size_t);
 
-    return current_block_size;
+    return origin_pointer_size + current_block_size;
 }
 
 void** allocator_base::get_first_available_block_address_address() const noexcept
 {
-    return reinterpret_cast<void**>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*) + sizeof(allocator_fit_allocation::allocation_mode));
+    return reinterpret_cast<void**>(reinterpret_cast<unsigned char*>(_trusted_memory) + first_available_block_address_offset);
 }
 
 void* allocator_base::get_first_available_block_address() const noexcept
@@ -144,12 +128,12 @@ void* allocator_base::get_available_block_next_available_block_address(
 size_t allocator_base::get_occupied_block_size(
     void const* current_block_address) const
 {
-    return *reinterpret_cast<size_t const*>(current_block_address);
+    return *reinterpret_cast<size_t const*>(reinterpret_cast<void* const*>(current_block_address) + 1);
 }
 
 void allocator_base::dump_trusted_memory_blocks_state() const
 {
-    if (get_logger() == nullptr)
+    if (!is_enabled_with_guard(logger::severity::debug))
     {
         return;
     }
@@ -179,50 +163,94 @@ void allocator_base::dump_trusted_memory_blocks_state() const
         current_block += current_block_size;
     }
 
-    this->debug_with_guard("Memory state: " + to_dump);
+    this->debug_with_guard([&] { return "Memory state: " + to_dump; });
+}
+
+void* allocator_base::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!is_block_size_supported(requested_block_size, alignment))
+    {
+        auto const warning_message = "no memory available to allocate";
+        this->warning_with_guard(warning_message);
+        throw memory_exception(warning_message);
+    }
+
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+    // block keeps the address got from global new and its size right before the data, the data is aligned within the padding
+    auto const alignment_padding_size = alignment > sizeof(size_t)
+        ? alignment
+        : 0;
+
+    void* origin_block = ::operator new(occupied_block_service_block_size + alignment_padding_size + requested_block_size);
+
+    if (origin_block == nullptr)
+    {
+        auto const warning_message = "no memory available to allocate";
+        this->warning_with_guard(warning_message);
+        throw memory_exception(warning_message);
+    }
+
+    auto* const occupied_block = reinterpret_cast<unsigned char*>(origin_block) + get_aligned_block_offset(origin_block, occupied_block_service_block_size, alignment, 0);
+    *reinterpret_cast<void**>(occupied_block) = origin_block;
+    *reinterpret_cast<size_t*>(reinterpret_cast<void**>(occupied_block) + 1) = requested_block_size;
+
+    auto* const allocated_block = reinterpret_cast<void*>(occupied_block + occupied_block_service_block_size);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); });
+
+    this->debug_with_guard([&] { return "After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
+        address_to_hex(allocated_block) + "):"; });
+    dump_trusted_memory_blocks_state();
+    return allocated_block;
 }
 
 void* allocator_base::allocate(
     size_t requested_block_size)
 {
-    auto const got_typename = get_typename();
-    this->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution started")
-        ->debug_with_guard("Requested " + std::to_string(requested_block_size) + " bytes of memory");
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
 
-    auto requested_block_size_overridden = requested_block_size;
+    auto* const allocated_block = allocate_block(requested_block_size, sizeof(size_t));
 
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
 
-    void* allocated_block = ::operator new(requested_block_size_overridden);
+    return allocated_block;
+}
+
+void* allocator_base::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
 
-    if (allocated_block == nullptr)
+    if (!is_alignment_valid(alignment))
     {
-        auto const warning_message = "no memory available to allocate";
+        auto const warning_message = "alignment should be a power of 2";
         this->warning_with_guard(warning_message)
-            ->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution finished");
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
         throw memory_exception(warning_message);
     }
 
-    this->trace_with_guard("Allocated block placed at " + address_to_hex(allocated_block))
-        ->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution finished");
+    auto* const allocated_block = allocate_block(requested_block_size, alignment);
 
-    this->debug_with_guard("After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
-        address_to_hex(allocated_block) + "):");
-    dump_trusted_memory_blocks_state();
-    return allocated_block;
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
 
+    return allocated_block;
 }
 
 void allocator_base::deallocate(
     void* block_to_deallocate_address)
 {
-    auto const got_typename = get_typename();
-    this->trace_with_guard(got_typename + "::deallocate(void *block_to_deallocate_address) execution started");
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
 
-    ::operator delete(block_to_deallocate_address);
+    ::operator delete(*reinterpret_cast<void**>(reinterpret_cast<unsigned char*>(block_to_deallocate_address) - get_occupied_block_service_block_size()));
 
-    this->debug_with_guard("After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):");
+    this->debug_with_guard([&] { return "After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):"; });
     dump_trusted_memory_blocks_state();
-    this->trace_with_guard(got_typename + "::deallocate method execution finished");
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
 
 }
 
@@ -266,12 +294,12 @@ bool allocator_base::reallocate(
 void allocator_base::setup_allocation_mode(
     allocator_fit_allocation::allocation_mode mode)
 {
-    *reinterpret_cast<allocator_fit_allocation::allocation_mode*>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*)) = mode;
+    reinterpret_cast<trusted_memory_header*>(_trusted_memory)->allocation_mode = mode;
 }
 
 logger* allocator_base::get_logger() const noexcept
 {
-    return *reinterpret_cast<logger**>(reinterpret_cast<allocator**>(reinterpret_cast<size_t*>(_trusted_memory) + 1) + 1);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->logger;
 }
 
 std::string allocator_base::get_typename() const noexcept
@@ -281,6 +309,6 @@ std::string allocator_base::get_typename() const noexcept
 
 allocator* allocator_base::get_allocator() const noexcept
 {
-    return *reinterpret_cast<allocator**>(reinterpret_cast<size_t*>(_trusted_memory) + 1);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->outer_allocator;
 }
 
@@ -9,16 +9,19 @@
 #include "allocator_holder.h"
 
 class allocator_base final :
-    public allocator_fit_allocation,
-    protected logger_holder,
-    protected typename_holder,
-    protected allocator_holder
+    public allocator_fit_allocation
 {
 
 private:
 
     void* _trusted_memory;
-    allocator* outer_allocator_;
+
+private:
+
+    // trusted memory: [header][first available block address][padding][first block]
+    static constexpr size_t first_available_block_address_offset = sizeof(trusted_memory_header);
+
+    static constexpr size_t first_block_offset = get_first_block_offset(first_available_block_address_offset + sizeof(void*));
 
 public:
 
@@ -63,6 +66,12 @@ private:
 
     void dump_trusted_memory_blocks_state() const override;
 
+private:
+
+    [[nodiscard]] void* allocate_block(
+        size_t requested_block_size,
+        size_t alignment) override;
+
 public:
 
     void* allocate(
@@ -79,6 +88,10 @@ public:
         void** block_to_reallocate_address_address,
         size_t new_block_size) override;
 
+    [[nodiscard]] void* allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
 public:
 
     void setup_allocation_mode(
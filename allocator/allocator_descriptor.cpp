@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <mutex>
+#include <new>
 #include "allocator_descriptor.h"
 
 allocator_descriptor::allocator_descriptor(
@@ -14,6 +17,9 @@ allocator_descriptor::allocator_descriptor(
             ->debug("requested memory size: " + std::to_string(memory_size) + " bytes");
     }
 
+    // block sizes are kept multiple of block alignment, so the lowest bit of boundary tags holds block occupancy
+    memory_size = memory_size / block_alignment * block_alignment;
+
     auto const minimal_trusted_memory_size = get_available_block_service_block_size();
 
     if (memory_size < minimal_trusted_memory_size)
@@ -29,31 +35,29 @@ allocator_descriptor::allocator_descriptor(
     }
 
     auto const allocator_service_block_size = get_allocator_service_block_size();
+    auto const fence_block_size = sizeof(size_t);
 
     _trusted_memory = outer_allocator == nullptr
-        ? ::operator new(memory_size + allocator_service_block_size)
-        : outer_allocator->allocate(memory_size + allocator_service_block_size);
-
-    auto* const memory_size_space = reinterpret_cast<size_t*>(_trusted_memory);
-    *memory_size_space = memory_size;
-
-    auto* const outer_allocator_pointer_space = reinterpret_cast<allocator**>(memory_size_space + 1);
-    *outer_allocator_pointer_space = outer_allocator;
+        ? ::operator new(memory_size + allocator_service_block_size + fence_block_size, std::align_val_t(cache_line_size))
+        : outer_allocator->allocate_aligned(memory_size + allocator_service_block_size + fence_block_size, cache_line_size);
 
-    auto* const logger_pointer_space = reinterpret_cast<logger**>(outer_allocator_pointer_space + 1);
-    *logger_pointer_space = log;
+    auto* const header = new (_trusted_memory) trusted_memory_header();
+    header->allocation_mode = allocation_mode;
+    header->logger = log;
+    header->memory_size = memory_size;
+    header->outer_allocator = outer_allocator;
 
-    auto* const allocation_mode_space = reinterpret_cast<allocator_fit_allocation::allocation_mode*>(logger_pointer_space + 1);
-    *allocation_mode_space = allocation_mode;
+    initialize_growth_service_block(get_growth_service_block_address());
 
-    auto* const first_available_block_pointer_space = reinterpret_cast<void**>(allocation_mode_space + 1);
-    *first_available_block_pointer_space = reinterpret_cast<void*>(first_available_block_pointer_space + 1);
+    auto* const first_available_block_pointer_space = get_first_available_block_address_address();
+    *first_available_block_pointer_space = nullptr;
 
-    auto* const first_available_block_size_space = reinterpret_cast<size_t*>(*first_available_block_pointer_space);
-    *first_available_block_size_space = memory_size;
+    // occupied zero-sized footer before the first block and header after the last one stop neighbours lookup
+    auto* const first_block = reinterpret_cast<unsigned char*>(_trusted_memory) + allocator_service_block_size;
+    *(reinterpret_cast<size_t*>(first_block) - 1) = block_occupancy_flag;
+    *reinterpret_cast<size_t*>(first_block + memory_size) = block_occupancy_flag;
 
-    auto* const first_available_block_next_block_address_space = reinterpret_cast<void**>(first_available_block_size_space + 1);
-    *first_available_block_next_block_address_space = nullptr;
+    insert_available_block(first_block, memory_size);
 
     this->trace_with_guard(got_typename + " allocator instance construction finished");
 }
@@ -65,7 +69,9 @@ allocator_descriptor::~allocator_descriptor() noexcept
 
     auto const* const logger = get_logger();
 
-    deallocate_with_guard(_trusted_memory);
+    release_chunks();
+
+    deallocate_aligned_with_guard(_trusted_memory, cache_line_size);
 
     if (logger != nullptr)
     {
@@ -75,43 +81,40 @@ allocator_descriptor::~allocator_descriptor() noexcept
 
 size_t allocator_descriptor::get_trusted_memory_size() const noexcept
 {
-    return *reinterpret_cast<size_t*>(_trusted_memory);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->memory_size;
 }
 
 allocator_fit_allocation::allocation_mode allocator_descriptor::get_allocation_mode() const noexcept
 {
-    return *reinterpret_cast<allocator_fit_allocation::allocation_mode*>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*));
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->allocation_mode;
 }
 
 size_t allocator_descriptor::get_allocator_service_block_size() const noexcept
 {
-    auto const memory_size_size = sizeof(size_t);
-    auto const outer_allocator_pointer_size = sizeof(allocator*);
-    auto const logger_pointer_size = sizeof(logger*);
-    auto const allocation_mode_size = sizeof(allocator_fit_allocation::allocation_mode);
-    auto const first_available_block_pointer_size = sizeof(void*);
-
-    return memory_size_size + outer_allocator_pointer_size + logger_pointer_size + allocation_mode_size + first_available_block_pointer_size;
+    return first_block_offset;
 }
 
 size_t allocator_descriptor::get_available_block_service_block_size() const noexcept
 {
-    auto const current_block_size = sizeof(size_t);
+    auto const current_block_header_size = sizeof(size_t);
+    auto const previous_available_block_pointer_size = sizeof(void*);
     auto const next_available_block_pointer_size = sizeof(void*);
+    auto const current_block_footer_size = sizeof(size_t);
 
-    return current_block_size + next_available_block_pointer_size;
+    return current_block_header_size + previous_available_block_pointer_size + next_available_block_pointer_size + current_block_footer_size;
 }
 
 size_t allocator_descriptor::get_occupied_block_service_block_size() const noexcept
 {
-    auto const current_block_size = sizeof(size_t);
+    auto const current_block_header_size = sizeof(size_t);
+    auto const current_block_footer_size = sizeof(size_t);
 
-    return current_block_size;
+    return current_block_header_size + current_block_footer_size;
 }
 
 void** allocator_descriptor::get_first_available_block_address_address() const noexcept
 {
-    return reinterpret_cast<void**>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*) + sizeof(allocator_fit_allocation::allocation_mode));
+    return reinterpret_cast<void**>(reinterpret_cast<unsigned char*>(_trusted_memory) + first_available_block_address_offset);
 }
 
 void* allocator_descriptor::get_first_available_block_address() const noexcept
@@ -119,92 +122,158 @@ void* allocator_descriptor::get_first_available_block_address() const noexcept
     return *get_first_available_block_address_address();
 }
 
+bool allocator_descriptor::get_block_occupancy(
+    void const* block_pointer) const
+{
+    return (*reinterpret_cast<size_t const*>(block_pointer) & block_occupancy_flag) != 0;
+}
+
 size_t allocator_descriptor::get_available_block_size(
     void const* current_block_address) const
 {
-    return *reinterpret_cast<size_t const*>(current_block_address);
+    return *reinterpret_cast<size_t const*>(current_block_address) & ~block_occupancy_flag;
 }
 
-void* allocator_descriptor::get_available_block_next_available_block_address(
+void* allocator_descriptor::get_available_block_previous_available_block_address(
     void const* current_block_address) const
 {
     return *reinterpret_cast<void* const*>(reinterpret_cast<size_t const*>(current_block_address) + 1);
 }
 
+void* allocator_descriptor::get_available_block_next_available_block_address(
+    void const* current_block_address) const
+{
+    return *(reinterpret_cast<void* const*>(reinterpret_cast<size_t const*>(current_block_address) + 1) + 1);
+}
+
 size_t allocator_descriptor::get_occupied_block_size(
     void const* current_block_address) const
 {
-    return *reinterpret_cast<size_t const*>(current_block_address);
+    return *reinterpret_cast<size_t const*>(current_block_address) & ~block_occupancy_flag;
 }
 
 void allocator_descriptor::dump_trusted_memory_blocks_state() const
 {
-    if (get_logger() == nullptr)
+    if (!is_enabled_with_guard(logger::severity::debug))
     {
         return;
     }
 
     std::string to_dump("|");
-    auto memory_size = get_trusted_memory_size();
-    auto current_available_block = get_first_available_block_address();
-    unsigned char* first_block = reinterpret_cast<unsigned char*>(_trusted_memory) + get_allocator_service_block_size();
-    unsigned char* current_block = first_block;
+    auto* current_block = reinterpret_cast<unsigned char*>(_trusted_memory) + get_allocator_service_block_size();
+    size_t current_block_size;
 
-    while (current_block - first_block < memory_size)
+    while ((current_block_size = get_occupied_block_size(current_block)) != 0)
     {
-        size_t current_block_size;
-        if (current_block == current_available_block)
-        {
-            current_block_size = get_available_block_size(current_block);
-            to_dump += "avl ";
-            current_available_block = get_available_block_next_available_block_address(current_available_block);
-        }
-        else
-        {
-            current_block_size = get_occupied_block_size(current_block);
-            to_dump += "occ ";
-        }
+        to_dump += get_block_occupancy(current_block)
+            ? "occ "
+            : "avl ";
 
         to_dump += std::to_string(current_block_size) + "|";
         current_block += current_block_size;
     }
 
-    this->debug_with_guard("Memory state: " + to_dump);
+    this->debug_with_guard([&] { return "Memory state: " + to_dump; });
 }
 
-void* allocator_descriptor::allocate(
-    size_t requested_block_size)
+void allocator_descriptor::set_block_boundary_tags(
+    void* block_address,
+    size_t block_size,
+    bool block_occupancy) const noexcept
 {
-    auto const got_typename = get_typename();
-    this->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution started")
-        ->debug_with_guard("Requested " + std::to_string(requested_block_size) + " bytes of memory");
+    auto const boundary_tag = block_occupancy
+        ? block_size | block_occupancy_flag
+        : block_size;
+
+    *reinterpret_cast<size_t*>(block_address) = boundary_tag;
+    *reinterpret_cast<size_t*>(reinterpret_cast<unsigned char*>(block_address) + block_size - sizeof(size_t)) = boundary_tag;
+}
 
-    auto requested_block_size_overridden = requested_block_size;
-    if (requested_block_size_overridden < sizeof(void*))
+void allocator_descriptor::insert_available_block(
+    void* block_address,
+    size_t block_size)
+{
+    set_block_boundary_tags(block_address, block_size, false);
+
+    auto* const first_available_block_address_address = get_first_available_block_address_address();
+    auto* const next_available_block = *first_available_block_address_address;
+
+    auto* const previous_available_block_address_address = reinterpret_cast<void**>(reinterpret_cast<size_t*>(block_address) + 1);
+    *previous_available_block_address_address = nullptr;
+    *(previous_available_block_address_address + 1) = next_available_block;
+
+    if (next_available_block != nullptr)
     {
-        requested_block_size_overridden = sizeof(void*);
+        *reinterpret_cast<void**>(reinterpret_cast<size_t*>(next_available_block) + 1) = block_address;
     }
 
-    void* previous_block = nullptr, * current_block = get_first_available_block_address();
-    void* target_block = nullptr, * previous_to_target_block = nullptr, * next_to_target_block = nullptr;
-    auto const available_block_service_block_size = get_available_block_service_block_size();
-    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+    *first_available_block_address_address = block_address;
+}
+
+void allocator_descriptor::remove_available_block(
+    void* block_address)
+{
+    auto* const previous_available_block = get_available_block_previous_available_block_address(block_address);
+    auto* const next_available_block = get_available_block_next_available_block_address(block_address);
+
+    previous_available_block == nullptr
+        ? *get_first_available_block_address_address() = next_available_block
+        : *(reinterpret_cast<void**>(reinterpret_cast<size_t*>(previous_available_block) + 1) + 1) = next_available_block;
+
+    if (next_available_block != nullptr)
+    {
+        *reinterpret_cast<void**>(reinterpret_cast<size_t*>(next_available_block) + 1) = previous_available_block;
+    }
+
+    // rover always refers to a listed block, so it moves on when its block is taken or merged
+    auto* const next_fit_rover_address_address = get_next_fit_rover_address_address();
+    if (*next_fit_rover_address_address == block_address)
+    {
+        *next_fit_rover_address_address = next_available_block;
+    }
+}
+
+void* allocator_descriptor::find_available_block(
+    size_t block_size) const
+{
+    void* target_block = nullptr;
     auto const allocation_mode = get_allocation_mode();
 
-    while (current_block != nullptr)
+    if (allocation_mode == allocator_fit_allocation::allocation_mode::next_fit)
+    {
+        // the list is scanned from the rover to its end, then from its head up to the rover
+        auto* const rover = *get_next_fit_rover_address_address();
+
+        for (auto* current_block = rover == nullptr ? get_first_available_block_address() : rover; current_block != nullptr; current_block = get_available_block_next_available_block_address(current_block))
+        {
+            if (get_available_block_size(current_block) >= block_size)
+            {
+                return current_block;
+            }
+        }
+
+        for (auto* current_block = rover == nullptr ? nullptr : get_first_available_block_address(); current_block != rover; current_block = get_available_block_next_available_block_address(current_block))
+        {
+            if (get_available_block_size(current_block) >= block_size)
+            {
+                return current_block;
+            }
+        }
+
+        return nullptr;
+    }
+
+    for (auto* current_block = get_first_available_block_address(); current_block != nullptr; current_block = get_available_block_next_available_block_address(current_block))
     {
         auto const current_block_size = get_available_block_size(current_block);
-        auto const next_block = get_available_block_next_available_block_address(current_block);
 
-        if (current_block_size >= requested_block_size_overridden + occupied_block_service_block_size)
+        if (current_block_size >= block_size)
         {
             if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit ||
-                allocation_mode == allocator_fit_allocation::allocation_mode::the_best_fit && (target_block == nullptr || current_block_size < get_available_block_size(target_block)) ||
-                allocation_mode == allocator_fit_allocation::allocation_mode::the_worst_fit && (target_block == nullptr || current_block_size > get_available_block_size(target_block)))
+                (allocation_mode == allocator_fit_allocation::allocation_mode::the_best_fit && (target_block == nullptr || current_block_size < get_available_block_size(target_block))) ||
+                (allocation_mode == allocator_fit_allocation::allocation_mode::the_worst_fit && (target_block == nullptr || current_block_size > get_available_block_size(target_block))))
             {
-                previous_to_target_block = previous_block;
                 target_block = current_block;
-                next_to_target_block = next_block;
             }
 
             if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit)
@@ -212,157 +281,326 @@ void* allocator_descriptor::allocate(
                 break;
             }
         }
+    }
+
+    return target_block;
+}
+
+void allocator_descriptor::set_occupied_block_size(
+    void* block_address,
+    size_t block_size)
+{
+    set_block_boundary_tags(block_address, block_size, true);
+}
+
+size_t allocator_descriptor::get_previous_available_block_size(
+    void const* block_address) const
+{
+    auto const previous_block_footer = *(reinterpret_cast<size_t const*>(block_address) - 1);
+
+    return (previous_block_footer & block_occupancy_flag) == 0
+        ? previous_block_footer
+        : 0;
+}
+
+void* allocator_descriptor::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!is_block_size_supported(requested_block_size, alignment))
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
 
-        previous_block = current_block;
-        current_block = next_block;
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    auto const available_block_service_block_size = get_available_block_service_block_size();
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+
+    auto requested_block_size_overridden = get_aligned_block_size(requested_block_size + occupied_block_service_block_size) - occupied_block_service_block_size;
+    if (requested_block_size_overridden + occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = available_block_service_block_size - occupied_block_service_block_size;
     }
 
+    // space skipped to align the block is left available, so it should fit an available block
+    auto const alignment_padding_size = alignment > block_alignment
+        ? alignment + available_block_service_block_size
+        : 0;
+
+    auto* target_block = find_available_block(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size);
+
     if (target_block == nullptr)
     {
-        auto const warning_message = "no memory available to allocate";
+        target_block = grow(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size, lock);
+    }
 
-        this->warning_with_guard(warning_message)
-            ->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution finished");
+    if (target_block == nullptr)
+    {
+        this->warning_with_guard("no memory available to allocate");
 
-        throw memory_exception(warning_message);
+        return nullptr;
     }
 
-    auto const target_block_size = get_available_block_size(target_block);
+    // next fit resumes from the rest of the taken block or, if it is taken whole, from the block listed after it
+    *get_next_fit_rover_address_address() = target_block;
+
+    auto target_block_size = get_available_block_size(target_block);
+    remove_available_block(target_block);
+
+    auto const aligned_block_offset = get_aligned_block_offset(target_block, sizeof(size_t), alignment, available_block_service_block_size);
+
+    if (aligned_block_offset != 0)
+    {
+        insert_available_block(target_block, aligned_block_offset);
+        target_block = reinterpret_cast<unsigned char*>(target_block) + aligned_block_offset;
+        target_block_size -= aligned_block_offset;
+    }
 
     if (target_block_size - requested_block_size_overridden - occupied_block_service_block_size < available_block_service_block_size)
     {
         requested_block_size_overridden = target_block_size - occupied_block_service_block_size;
     }
+    else
+    {
+        auto* const rest_block = reinterpret_cast<unsigned char*>(target_block) + occupied_block_service_block_size + requested_block_size_overridden;
+        insert_available_block(rest_block, target_block_size - occupied_block_service_block_size - requested_block_size_overridden);
+        *get_next_fit_rover_address_address() = rest_block;
+    }
 
     if (requested_block_size_overridden != requested_block_size)
     {
-        this->trace_with_guard("Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(requested_block_size_overridden) + " bytes in according to correct work of allocator");
+        this->trace_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(requested_block_size_overridden) + " bytes in according to correct work of allocator"; });
 
         requested_block_size = requested_block_size_overridden;
     }
 
-    void* updated_next_block_to_previous_block;
+    set_block_boundary_tags(target_block, requested_block_size + occupied_block_service_block_size, true);
+
+    auto* const allocated_block = reinterpret_cast<void*>(reinterpret_cast<size_t*>(target_block) + 1);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); });
+
+    this->debug_with_guard([&] { return "After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
+        address_to_hex(target_block) + "):"; });
+    dump_trusted_memory_blocks_state();
+    return allocated_block;
+}
 
-    if (requested_block_size == target_block_size - occupied_block_service_block_size)
+void* allocator_descriptor::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto* const allocated_block = allocate_block(requested_block_size, block_alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    if (allocated_block == nullptr)
     {
-        updated_next_block_to_previous_block = next_to_target_block;
+        throw memory_exception("no memory available to allocate");
     }
-    else
+
+    return allocated_block;
+}
+
+void* allocator_descriptor::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
     {
-        updated_next_block_to_previous_block = reinterpret_cast<void*>(reinterpret_cast<unsigned char*>(target_block) + occupied_block_service_block_size + requested_block_size);
+        auto const warning_message = "alignment should be a power of 2";
 
-        auto* const target_block_leftover_size = reinterpret_cast<size_t*>(updated_next_block_to_previous_block);
-        *target_block_leftover_size = target_block_size - occupied_block_service_block_size - requested_block_size;
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
 
-        auto* const target_block_leftover_next_block_address = reinterpret_cast<void**>(target_block_leftover_size + 1);
-        *target_block_leftover_next_block_address = next_to_target_block;
+        throw memory_exception(warning_message);
     }
 
-    previous_to_target_block == nullptr
-        ? *get_first_available_block_address_address() = updated_next_block_to_previous_block
-        : *reinterpret_cast<void**>(reinterpret_cast<size_t*>(previous_to_target_block) + 1) = updated_next_block_to_previous_block;
-
-    auto* target_block_size_address = reinterpret_cast<size_t*>(target_block);
-    *target_block_size_address = requested_block_size + sizeof(size_t);
+    auto* const allocated_block = allocate_block(requested_block_size, alignment);
 
-    auto* const allocated_block = reinterpret_cast<void*>(target_block_size_address + 1);
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
 
-    this->trace_with_guard("Allocated block placed at " + address_to_hex(allocated_block))
-        ->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution finished");
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
 
-    this->debug_with_guard("After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
-        address_to_hex(target_block_size_address) + "):");
-    dump_trusted_memory_blocks_state();
     return allocated_block;
 }
 
+void* allocator_descriptor::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    try
+    {
+        return allocate_block(requested_block_size, block_alignment);
+    }
+    catch (...)
+    {
+        // outer allocator may throw while heap grows
+        return nullptr;
+    }
+}
+
+void allocator_descriptor::allocate_batch(
+    size_t requested_block_size,
+    size_t blocks_count,
+    void** allocated_blocks_addresses)
+{
+    allocate_batch_blocks(*get_lock(), requested_block_size, blocks_count, allocated_blocks_addresses);
+}
+
 void allocator_descriptor::deallocate(
     void* block_to_deallocate_address)
 {
-    auto got_typename = get_typename();
-    this->trace_with_guard(got_typename + "::deallocate(void *block_to_deallocate_address) execution started");
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
 
-    auto* block_to_deallocate_size_descriptor = reinterpret_cast<size_t*>(block_to_deallocate_address) - 1;
-    size_t block_to_deallocate_size = *block_to_deallocate_size_descriptor;
+    std::unique_lock<spinlock> lock(*get_lock());
 
-    // Получаем указатель на следующий доступный блок
-    void** next_block_address = reinterpret_cast<void**>(block_to_deallocate_size_descriptor + 1);
-    void* next_block = *next_block_address;
+    // TODO: check if memory was allocated from current allocator
+    auto* block_to_deallocate = reinterpret_cast<unsigned char*>(block_to_deallocate_address) - sizeof(size_t);
 
-    // Получаем указатель на предыдущий доступный блок
-    void* previous_block = nullptr;
-    unsigned char* current_block_address = reinterpret_cast<unsigned char*>(get_first_available_block_address());
+    dump_occupied_block_before_deallocate(block_to_deallocate, get_logger());
 
-    while (current_block_address != nullptr && current_block_address < block_to_deallocate_address) {
-        previous_block = current_block_address;
-        current_block_address = reinterpret_cast<unsigned char*>(reinterpret_cast<size_t>(current_block_address) + 1);
-    }
+    auto block_to_deallocate_size = get_occupied_block_size(block_to_deallocate);
+    auto* const previous_block_footer = reinterpret_cast<size_t*>(block_to_deallocate) - 1;
+    auto* const next_block = block_to_deallocate + block_to_deallocate_size;
 
-    if (previous_block == nullptr) {
-        // Предыдущего доступного блока нет, поэтому обновляем начало списка доступных блоков
-        *get_first_available_block_address_address() = block_to_deallocate_address;
+    if ((*previous_block_footer & block_occupancy_flag) == 0)
+    {
+        this->trace_with_guard("Merging previous available block with target block...");
+        block_to_deallocate -= *previous_block_footer;
+        block_to_deallocate_size += *previous_block_footer;
+        remove_available_block(block_to_deallocate);
+        this->trace_with_guard("Merging completed");
     }
-    else {
-        // Обновляем указатель предыдущего доступного блока на следующий доступный блок
-        *reinterpret_cast<void**>(reinterpret_cast<size_t*>(previous_block) + 1) = block_to_deallocate_address;
+
+    if (!get_block_occupancy(next_block))
+    {
+        this->trace_with_guard("Merging next available block with target block...");
+        block_to_deallocate_size += get_available_block_size(next_block);
+        remove_available_block(next_block);
+        this->trace_with_guard("Merging completed");
     }
 
-    if (current_block_address != nullptr) {
-        // Если есть следующий доступный блок, объединяем блоки
-        size_t new_block_size = block_to_deallocate_size + (size_t)(current_block_address - reinterpret_cast<unsigned char*>(block_to_deallocate_address));
+    auto* const released_chunk = unlink_released_chunk(get_growth_service_block_address(), block_to_deallocate, block_to_deallocate_size);
 
-        // Обновляем размер и указатель на следующий блок
-        *block_to_deallocate_size_descriptor = new_block_size;
-        *next_block_address = reinterpret_cast<void*>(reinterpret_cast<size_t*>(block_to_deallocate_address) + 1 + new_block_size / sizeof(size_t));
-    }
-    else {
-        // Если нет следующего доступного блока, обновляем размер и указатель на следующий блок
-        *block_to_deallocate_size_descriptor = block_to_deallocate_size;
-        *next_block_address = nullptr;
+    if (released_chunk == nullptr)
+    {
+        insert_available_block(block_to_deallocate, block_to_deallocate_size);
     }
 
-    this->debug_with_guard("After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):");
+    this->debug_with_guard([&] { return "After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):"; });
     dump_trusted_memory_blocks_state();
-    this->trace_with_guard(got_typename + "::deallocate method execution finished");
+    lock.unlock();
 
+    if (released_chunk != nullptr)
+    {
+        release_chunk(released_chunk);
+    }
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void allocator_descriptor::deallocate_batch(
+    void** blocks_to_deallocate_addresses,
+    size_t blocks_count)
+{
+    deallocate_batch_blocks(*get_lock(), blocks_to_deallocate_addresses, blocks_count);
 }
 
 void* allocator_descriptor::reallocate(
     void* block_to_reallocate_address,
     size_t new_block_size)
 {
-    auto* new_block = allocate(new_block_size);
-    auto occupied_block_service_block_size = get_occupied_block_service_block_size();
-    auto data_to_move_size = std::min(get_occupied_block_size(reinterpret_cast<unsigned char const*>(new_block) - occupied_block_service_block_size), get_occupied_block_size(reinterpret_cast<unsigned char const*>(block_to_reallocate_address) - occupied_block_service_block_size)) - occupied_block_service_block_size;
-    memcpy(new_block, block_to_reallocate_address, data_to_move_size);
-    deallocate(block_to_reallocate_address);
-    return new_block;
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(new_block_size) + " bytes of memory for block placed at " + address_to_hex(block_to_reallocate_address); });
+
+    auto* const reallocated_block = reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+    if (reallocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return reallocated_block;
 }
 
 bool allocator_descriptor::reallocate(
     void** block_to_reallocate_address_address,
     size_t new_block_size)
 {
-    try {
-        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
-        return true;
-    }
-    catch (std::exception const& ex)
+    auto* const reallocated_block = try_reallocate(*block_to_reallocate_address_address, new_block_size);
+
+    if (reallocated_block == nullptr)
     {
-        this->warning_with_guard(ex.what());
         return false;
     }
+
+    *block_to_reallocate_address_address = reallocated_block;
+    return true;
+}
+
+void* allocator_descriptor::try_reallocate(
+    void* block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    try
+    {
+        return reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+    }
+    catch (...)
+    {
+        // outer allocator may throw while heap grows
+        return nullptr;
+    }
 }
 
 void allocator_descriptor::setup_allocation_mode(
     allocator_fit_allocation::allocation_mode mode)
 {
-    *reinterpret_cast<allocator_fit_allocation::allocation_mode*>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*)) = mode;
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    reinterpret_cast<trusted_memory_header*>(_trusted_memory)->allocation_mode = mode;
+}
+
+void allocator_descriptor::setup_growth(
+    size_t chunk_size,
+    size_t free_chunks_high_water_mark)
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    setup_growth_service_block(get_growth_service_block_address(), std::max(chunk_size, get_available_block_service_block_size()), free_chunks_high_water_mark);
+}
+
+spinlock* allocator_descriptor::get_lock() const noexcept
+{
+    return &reinterpret_cast<trusted_memory_header*>(_trusted_memory)->lock;
+}
+
+void** allocator_descriptor::get_next_fit_rover_address_address() const noexcept
+{
+    return &reinterpret_cast<trusted_memory_header*>(_trusted_memory)->next_fit_rover;
+}
+
+void* allocator_descriptor::get_growth_service_block_address() const noexcept
+{
+    return reinterpret_cast<unsigned char*>(_trusted_memory) + growth_service_block_offset;
 }
 
 logger* allocator_descriptor::get_logger() const noexcept
 {
-    return *reinterpret_cast<logger**>(reinterpret_cast<allocator**>(reinterpret_cast<size_t*>(_trusted_memory) + 1) + 1);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->logger;
 }
 
 std::string allocator_descriptor::get_typename() const noexcept
@@ -372,5 +610,5 @@ std::string allocator_descriptor::get_typename() const noexcept
 
 allocator* allocator_descriptor::get_allocator() const noexcept
 {
-    return *reinterpret_cast<allocator**>(reinterpret_cast<size_t*>(_trusted_memory) + 1);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->outer_allocator;
 }
@@ -1,24 +1,34 @@
 #ifndef DATA_STRUCTURES_CPP_MEMORY_WITH_DESCRIPTOR_DEALLOCATION_H
 #define DATA_STRUCTURES_CPP_MEMORY_WITH_DESCRIPTOR_DEALLOCATION_H
 
+#include <mutex>
 #include "typename_holder.h"
 #include "logger.h"
 #include "logger_holder.h"
 #include "allocator.h"
 #include "allocator_fit_allocation.h"
 #include "allocator_holder.h"
+#include "spinlock.h"
 
 class allocator_descriptor final :
-    public allocator_fit_allocation,
-    protected logger_holder,
-    protected typename_holder,
-    protected allocator_holder
+    public allocator_fit_allocation
 {
 
 private:
 
     void* _trusted_memory;
 
+private:
+
+    static constexpr size_t block_occupancy_flag = 1;
+
+    // trusted memory: [header][first available block address][growth service block][padding][first block previous fence][blocks...][last block next fence]
+    static constexpr size_t first_available_block_address_offset = sizeof(trusted_memory_header);
+
+    static constexpr size_t growth_service_block_offset = first_available_block_address_offset + sizeof(void*);
+
+    static constexpr size_t first_block_offset = get_first_block_offset(growth_service_block_offset + growth_service_block_size + sizeof(size_t));
+
 public:
 
     explicit allocator_descriptor(
@@ -51,9 +61,15 @@ private:
 
     [[nodiscard]] void* get_first_available_block_address() const noexcept override;
 
+    [[nodiscard]] bool get_block_occupancy(
+        void const* block_pointer) const override;
+
     size_t get_available_block_size(
         void const* current_block_address) const override;
 
+    void* get_available_block_previous_available_block_address(
+        void const* current_block_address) const override;
+
     void* get_available_block_next_available_block_address(
         void const* current_block_address) const override;
 
@@ -62,6 +78,40 @@ private:
 
     void dump_trusted_memory_blocks_state() const override;
 
+private:
+
+    [[nodiscard]] spinlock* get_lock() const noexcept;
+
+    [[nodiscard]] void** get_next_fit_rover_address_address() const noexcept override;
+
+    [[nodiscard]] void* get_growth_service_block_address() const noexcept override;
+
+    void set_block_boundary_tags(
+        void* block_address,
+        size_t block_size,
+        bool block_occupancy) const noexcept;
+
+    [[nodiscard]] void* find_available_block(
+        size_t block_size) const override;
+
+    void insert_available_block(
+        void* block_address,
+        size_t block_size) override;
+
+    void remove_available_block(
+        void* block_address) override;
+
+    [[nodiscard]] void* allocate_block(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    void set_occupied_block_size(
+        void* block_address,
+        size_t block_size) override;
+
+    [[nodiscard]] size_t get_previous_available_block_size(
+        void const* block_address) const override;
+
 public:
 
     void* allocate(
@@ -78,11 +128,35 @@ public:
         void** block_to_reallocate_address_address,
         size_t new_block_size) override;
 
+    [[nodiscard]] void* allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    [[nodiscard]] void* try_allocate(
+        size_t requested_block_size) noexcept override;
+
+    [[nodiscard]] void* try_reallocate(
+        void* block_to_reallocate_address,
+        size_t new_block_size) noexcept override;
+
+    void allocate_batch(
+        size_t requested_block_size,
+        size_t blocks_count,
+        void** allocated_blocks_addresses) override;
+
+    void deallocate_batch(
+        void** blocks_to_deallocate_addresses,
+        size_t blocks_count) override;
+
 public:
 
     void setup_allocation_mode(
         allocator_fit_allocation::allocation_mode mode) override;
 
+    void setup_growth(
+        size_t chunk_size,
+        size_t free_chunks_high_water_mark) override;
+
 private:
 
     [[nodiscard]] logger* get_logger() const noexcept override;
@@ -1,3 +1,7 @@
+#include <cstring>
+#include <mutex>
+#include <new>
+#include "bit_operations.h"
 #include "allocator_double_system.h"
 
 allocator_double_system::allocator_double_system(
@@ -14,6 +18,9 @@ allocator_double_system::allocator_double_system(
             ->debug("requested memory size: " + std::to_string(memory_size) + " bytes");
     }
 
+    // a block is always split off the smallest or the largest order available, there is no position to resume from
+    throw_if_next_fit_requested(allocation_mode, log);
+
     auto const minimal_trusted_memory_size = get_available_block_service_block_size();
 
     if (memory_size < minimal_trusted_memory_size)
@@ -28,32 +35,31 @@ allocator_double_system::allocator_double_system(
         throw allocator::memory_exception(error_message);
     }
 
+    // whole trusted memory is a single block, so its size should be a power of 2
+    auto const trusted_memory_order = get_block_order(memory_size);
+    memory_size = static_cast<size_t>(1) << trusted_memory_order;
+
     auto const allocator_service_block_size = get_allocator_service_block_size();
 
     _trusted_memory = outer_allocator == nullptr
-        ? ::operator new(memory_size + allocator_service_block_size)
-        : outer_allocator->allocate(memory_size + allocator_service_block_size);
-
-    auto* const memory_size_space = reinterpret_cast<size_t*>(_trusted_memory);
-    *memory_size_space = memory_size;
+        ? ::operator new(memory_size + allocator_service_block_size, std::align_val_t(cache_line_size))
+        : outer_allocator->allocate_aligned(memory_size + allocator_service_block_size, cache_line_size);
 
-    auto* const outer_allocator_pointer_space = reinterpret_cast<allocator**>(memory_size_space + 1);
-    *outer_allocator_pointer_space = outer_allocator;
+    auto* const header = new (_trusted_memory) trusted_memory_header();
+    header->allocation_mode = allocation_mode;
+    header->logger = log;
+    header->memory_size = memory_size;
+    header->outer_allocator = outer_allocator;
 
-    auto* const logger_pointer_space = reinterpret_cast<logger**>(outer_allocator_pointer_space + 1);
-    *logger_pointer_space = log;
+    *get_free_lists_occupancy_bitmap_address() = 0;
 
-    auto* const allocation_mode_space = reinterpret_cast<allocator_fit_allocation::allocation_mode*>(logger_pointer_space + 1);
-    *allocation_mode_space = allocation_mode;
-
-    auto* const first_available_block_pointer_space = reinterpret_cast<void**>(allocation_mode_space + 1);
-    *first_available_block_pointer_space = reinterpret_cast<void*>(first_available_block_pointer_space + 1);
-
-    auto* const first_available_block_size_space = reinterpret_cast<size_t*>(*first_available_block_pointer_space);
-    *first_available_block_size_space = memory_size;
+    auto* const free_lists = get_free_lists_address();
+    for (size_t i = 0; i < orders_count; i++)
+    {
+        free_lists[i] = nullptr;
+    }
 
-    auto* const first_available_block_next_block_address_space = reinterpret_cast<void**>(first_available_block_size_space + 1);
-    *first_available_block_next_block_address_space = nullptr;
+    insert_available_block_of_order(get_first_block_address(), trusted_memory_order);
 
     this->trace_with_guard(got_typename + " allocator instance construction finished");
 }
@@ -65,7 +71,7 @@ allocator_double_system::~allocator_double_system() noexcept
 
     auto const* const logger = get_logger();
 
-    deallocate_with_guard(_trusted_memory);
+    deallocate_aligned_with_guard(_trusted_memory, cache_line_size);
 
     if (logger != nullptr)
     {
@@ -75,31 +81,26 @@ allocator_double_system::~allocator_double_system() noexcept
 
 size_t allocator_double_system::get_trusted_memory_size() const noexcept
 {
-    return *reinterpret_cast<size_t*>(_trusted_memory);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->memory_size;
 }
 
 allocator_fit_allocation::allocation_mode allocator_double_system::get_allocation_mode() const noexcept
 {
-    return *reinterpret_cast<allocator_fit_allocation::allocation_mode*>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*));
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->allocation_mode;
 }
 
 size_t allocator_double_system::get_allocator_service_block_size() const noexcept
 {
-    auto const memory_size_size = sizeof(size_t);
-    auto const outer_allocator_pointer_size = sizeof(allocator*);
-    auto const logger_pointer_size = sizeof(logger*);
-    auto const allocation_mode_size = sizeof(allocator_fit_allocation::allocation_mode);
-    auto const first_available_block_pointer_size = sizeof(void*);
-
-    return memory_size_size + outer_allocator_pointer_size + logger_pointer_size + allocation_mode_size + first_available_block_pointer_size;
+    return first_block_offset;
 }
 
 size_t allocator_double_system::get_available_block_service_block_size() const noexcept
 {
     auto const current_block_size = sizeof(size_t);
+    auto const previous_available_block_pointer_size = sizeof(void*);
     auto const next_available_block_pointer_size = sizeof(void*);
 
-    return current_block_size + next_available_block_pointer_size;
+    return current_block_size + previous_available_block_pointer_size + next_available_block_pointer_size;
 }
 
 size_t allocator_double_system::get_occupied_block_service_block_size() const noexcept
@@ -109,272 +110,483 @@ size_t allocator_double_system::get_occupied_block_service_block_size() const no
     return current_block_size;
 }
 
-void** allocator_double_system::get_first_available_block_address_address() const noexcept
+bool allocator_double_system::get_block_occupancy(
+    void const* block_pointer) const
 {
-    return reinterpret_cast<void**>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*) + sizeof(allocator_fit_allocation::allocation_mode));
+    return (*reinterpret_cast<size_t const*>(block_pointer) & block_occupancy_flag) != 0;
 }
 
-void* allocator_double_system::get_first_available_block_address() const noexcept
+size_t allocator_double_system::get_available_block_size(
+    void const* current_block_address) const
 {
-    return *get_first_available_block_address_address();
+    return *reinterpret_cast<size_t const*>(current_block_address);
 }
 
-size_t allocator_double_system::get_available_block_size(
+void* allocator_double_system::get_available_block_previous_available_block_address(
     void const* current_block_address) const
 {
-    return *reinterpret_cast<size_t const*>(current_block_address);
+    return *reinterpret_cast<void* const*>(reinterpret_cast<size_t const*>(current_block_address) + 1);
 }
 
 void* allocator_double_system::get_available_block_next_available_block_address(
     void const* current_block_address) const
 {
-    return *reinterpret_cast<void* const*>(reinterpret_cast<size_t const*>(current_block_address) + 1);
+    return *(reinterpret_cast<void* const*>(reinterpret_cast<size_t const*>(current_block_address) + 1) + 1);
 }
 
 size_t allocator_double_system::get_occupied_block_size(
     void const* current_block_address) const
 {
-    return *reinterpret_cast<size_t const*>(current_block_address);
+    return *reinterpret_cast<size_t const*>(current_block_address) & ~block_occupancy_flag;
 }
 
 void allocator_double_system::dump_trusted_memory_blocks_state() const
 {
-    if (get_logger() == nullptr)
+    if (!is_enabled_with_guard(logger::severity::debug))
     {
         return;
     }
 
     std::string to_dump("|");
     auto memory_size = get_trusted_memory_size();
-    auto current_available_block = get_first_available_block_address();
-    unsigned char* first_block = reinterpret_cast<unsigned char*>(_trusted_memory) + get_allocator_service_block_size();
+    unsigned char* first_block = get_first_block_address();
     unsigned char* current_block = first_block;
 
     while (current_block - first_block < memory_size)
     {
         size_t current_block_size;
-        if (current_block == current_available_block)
+        if (get_block_occupancy(current_block))
         {
-            current_block_size = get_available_block_size(current_block);
-            to_dump += "avl ";
-            current_available_block = get_available_block_next_available_block_address(current_available_block);
+            current_block_size = get_occupied_block_size(current_block);
+            to_dump += "occ ";
         }
         else
         {
-            current_block_size = get_occupied_block_size(current_block);
-            to_dump += "occ ";
+            current_block_size = get_available_block_size(current_block);
+            to_dump += "avl ";
         }
 
         to_dump += std::to_string(current_block_size) + "|";
         current_block += current_block_size;
     }
 
-    this->debug_with_guard("Memory state: " + to_dump);
+    this->debug_with_guard([&] { return "Memory state: " + to_dump; });
 }
 
-void* allocator_double_system::allocate(
-    size_t requested_block_size)
+size_t* allocator_double_system::get_free_lists_occupancy_bitmap_address() const noexcept
+{
+    return reinterpret_cast<size_t*>(reinterpret_cast<unsigned char*>(_trusted_memory) + free_lists_occupancy_bitmap_offset);
+}
+
+void** allocator_double_system::get_free_lists_address() const noexcept
+{
+    return reinterpret_cast<void**>(get_free_lists_occupancy_bitmap_address() + 1);
+}
+
+unsigned char* allocator_double_system::get_first_block_address() const noexcept
 {
-    auto const got_typename = get_typename();
-    this->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution started")
-        ->debug_with_guard("Requested " + std::to_string(requested_block_size) + " bytes of memory");
+    return reinterpret_cast<unsigned char*>(_trusted_memory) + get_allocator_service_block_size();
+}
+
+size_t allocator_double_system::get_minimal_block_order() const noexcept
+{
+    return get_block_order(get_available_block_service_block_size());
+}
+
+size_t allocator_double_system::get_block_order(
+    size_t block_size) noexcept
+{
+    return block_size <= 1
+        ? 0
+        : bit_operations::find_last_set(block_size - 1) + 1;
+}
+
+void allocator_double_system::insert_available_block_of_order(
+    void* block_address,
+    size_t block_order)
+{
+    auto* const free_list_address = get_free_lists_address() + block_order;
+    auto* const block_size_address = reinterpret_cast<size_t*>(block_address);
+    *block_size_address = static_cast<size_t>(1) << block_order;
+
+    auto* const previous_available_block_address_address = reinterpret_cast<void**>(block_size_address + 1);
+    *previous_available_block_address_address = nullptr;
+    *(previous_available_block_address_address + 1) = *free_list_address;
 
-    auto requested_block_size_overridden = requested_block_size;
-    if (requested_block_size_overridden < sizeof(void*))
+    if (*free_list_address != nullptr)
     {
-        requested_block_size_overridden = sizeof(void*);
+        *reinterpret_cast<void**>(reinterpret_cast<size_t*>(*free_list_address) + 1) = block_address;
     }
 
-    void* previous_block = nullptr, * current_block = get_first_available_block_address();
-    void* target_block = nullptr, * previous_to_target_block = nullptr, * next_to_target_block = nullptr;
-    auto const available_block_service_block_size = get_available_block_service_block_size();
-    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
-    auto const allocation_mode = get_allocation_mode();
+    *free_list_address = block_address;
+    *get_free_lists_occupancy_bitmap_address() |= static_cast<size_t>(1) << block_order;
+}
+
+void allocator_double_system::remove_available_block_of_order(
+    void* block_address,
+    size_t block_order)
+{
+    auto* const previous_available_block = get_available_block_previous_available_block_address(block_address);
+    auto* const next_available_block = get_available_block_next_available_block_address(block_address);
 
-    while (current_block != nullptr)
+    if (previous_available_block == nullptr)
     {
-        auto const current_block_size = get_available_block_size(current_block);
-        auto const next_block = get_available_block_next_available_block_address(current_block);
+        get_free_lists_address()[block_order] = next_available_block;
 
-        if (current_block_size >= requested_block_size_overridden + occupied_block_service_block_size)
+        if (next_available_block == nullptr)
         {
-            if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit ||
-                allocation_mode == allocator_fit_allocation::allocation_mode::the_best_fit && (target_block == nullptr || current_block_size < get_available_block_size(target_block)) ||
-                allocation_mode == allocator_fit_allocation::allocation_mode::the_worst_fit && (target_block == nullptr || current_block_size > get_available_block_size(target_block)))
-            {
-                previous_to_target_block = previous_block;
-                target_block = current_block;
-                next_to_target_block = next_block;
-            }
-
-            if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit)
-            {
-                break;
-            }
+            *get_free_lists_occupancy_bitmap_address() &= ~(static_cast<size_t>(1) << block_order);
         }
+    }
+    else
+    {
+        *(reinterpret_cast<void**>(reinterpret_cast<size_t*>(previous_available_block) + 1) + 1) = next_available_block;
+    }
 
-        previous_block = current_block;
-        current_block = next_block;
+    if (next_available_block != nullptr)
+    {
+        *reinterpret_cast<void**>(reinterpret_cast<size_t*>(next_available_block) + 1) = previous_available_block;
     }
+}
 
-    if (target_block == nullptr)
+unsigned char* allocator_double_system::get_occupied_block_address(
+    void const* block_data_address) const
+{
+    auto const* const block_header = reinterpret_cast<unsigned char const*>(block_data_address) - get_occupied_block_service_block_size();
+    auto* const first_block = get_first_block_address();
+
+    // block offset within trusted memory is a multiple of its size, so the header of aligned data leads to the block start
+    return first_block + ((block_header - first_block) & ~(get_occupied_block_size(block_header) - 1));
+}
+
+void* allocator_double_system::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!is_block_size_supported(requested_block_size, alignment))
     {
-        auto const warning_message = "no memory available to allocate";
+        this->warning_with_guard("no memory available to allocate");
 
-        this->warning_with_guard(warning_message)
-            ->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution finished");
+        return nullptr;
+    }
 
-        throw memory_exception(warning_message);
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+    // data following block header is already aligned to block alignment; data aligned further is placed within
+    // alignment bytes from the block start, header goes right before it
+    auto const block_data_offset_limit = alignment > block_alignment
+        ? alignment
+        : occupied_block_service_block_size;
+    auto const requested_block_order = std::max(get_block_order(requested_block_size + block_data_offset_limit), get_minimal_block_order());
+    auto const free_lists_occupancy_bitmap = requested_block_order >= orders_count
+        ? 0
+        : *get_free_lists_occupancy_bitmap_address() & (~static_cast<size_t>(0) << requested_block_order);
+
+    if (free_lists_occupancy_bitmap == 0)
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
     }
 
-    auto const target_block_size = get_available_block_size(target_block);
+    // first fit and the best fit split the smallest sufficient block, the worst fit splits the largest one
+    auto target_block_order = get_allocation_mode() == allocator_fit_allocation::allocation_mode::the_worst_fit
+        ? bit_operations::find_last_set(free_lists_occupancy_bitmap)
+        : bit_operations::find_first_set(free_lists_occupancy_bitmap);
+
+    auto* const target_block = reinterpret_cast<unsigned char*>(get_free_lists_address()[target_block_order]);
+    remove_available_block_of_order(target_block, target_block_order);
 
-    if (target_block_size - requested_block_size_overridden - occupied_block_service_block_size < available_block_service_block_size)
+    while (target_block_order != requested_block_order)
     {
-        requested_block_size_overridden = target_block_size - occupied_block_service_block_size;
+        --target_block_order;
+        insert_available_block_of_order(target_block + (static_cast<size_t>(1) << target_block_order), target_block_order);
     }
 
-    if (requested_block_size_overridden != requested_block_size)
+    auto const target_block_size = static_cast<size_t>(1) << requested_block_order;
+    auto const aligned_block_offset = get_aligned_block_offset(target_block, occupied_block_service_block_size, alignment, 0);
+
+    if (target_block_size - occupied_block_service_block_size - aligned_block_offset != requested_block_size)
     {
-        this->trace_with_guard("Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(requested_block_size_overridden) + " bytes in according to correct work of allocator");
+        this->trace_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(target_block_size - occupied_block_service_block_size - aligned_block_offset) + " bytes in according to correct work of allocator"; });
 
-        requested_block_size = requested_block_size_overridden;
+        requested_block_size = target_block_size - occupied_block_service_block_size - aligned_block_offset;
     }
 
-    void* updated_next_block_to_previous_block;
+    // block start is tagged for buddies lookup, header right before aligned data leads deallocation back to the block start
+    auto* target_block_size_address = reinterpret_cast<size_t*>(target_block);
+    *target_block_size_address = target_block_size | block_occupancy_flag;
+    *reinterpret_cast<size_t*>(target_block + aligned_block_offset) = target_block_size | block_occupancy_flag;
+
+    auto* const allocated_block = reinterpret_cast<void*>(target_block + aligned_block_offset + occupied_block_service_block_size);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); });
+
+    this->debug_with_guard([&] { return "After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
+        address_to_hex(target_block_size_address) + "):"; });
+    dump_trusted_memory_blocks_state();
+    return allocated_block;
+}
+
+void* allocator_double_system::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto* const allocated_block = allocate_block(requested_block_size, block_alignment);
 
-    if (requested_block_size == target_block_size - occupied_block_service_block_size)
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    if (allocated_block == nullptr)
     {
-        updated_next_block_to_previous_block = next_to_target_block;
+        throw memory_exception("no memory available to allocate");
     }
-    else
+
+    return allocated_block;
+}
+
+void* allocator_double_system::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
     {
-        updated_next_block_to_previous_block = reinterpret_cast<void*>(reinterpret_cast<unsigned char*>(target_block) + occupied_block_service_block_size + requested_block_size);
+        auto const warning_message = "alignment should be a power of 2";
 
-        auto* const target_block_leftover_size = reinterpret_cast<size_t*>(updated_next_block_to_previous_block);
-        *target_block_leftover_size = target_block_size - occupied_block_service_block_size - requested_block_size;
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
 
-        auto* const target_block_leftover_next_block_address = reinterpret_cast<void**>(target_block_leftover_size + 1);
-        *target_block_leftover_next_block_address = next_to_target_block;
+        throw memory_exception(warning_message);
     }
 
-    previous_to_target_block == nullptr
-        ? *get_first_available_block_address_address() = updated_next_block_to_previous_block
-        : *reinterpret_cast<void**>(reinterpret_cast<size_t*>(previous_to_target_block) + 1) = updated_next_block_to_previous_block;
+    auto* const allocated_block = allocate_block(requested_block_size, alignment);
 
-    auto* target_block_size_address = reinterpret_cast<size_t*>(target_block);
-    *target_block_size_address = requested_block_size + sizeof(size_t);
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
 
-    auto* const allocated_block = reinterpret_cast<void*>(target_block_size_address + 1);
-
-    this->trace_with_guard("Allocated block placed at " + address_to_hex(allocated_block))
-        ->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution finished");
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
 
-    this->debug_with_guard("After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
-        address_to_hex(target_block_size_address) + "):");
-    dump_trusted_memory_blocks_state();
     return allocated_block;
 }
 
 void allocator_double_system::deallocate(
     void* block_to_deallocate_address)
 {
-    auto const got_typename = get_typename();
-    this->trace_with_guard(got_typename + "::deallocate(void *block_to_deallocate_address) execution started");
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    std::lock_guard<spinlock> lock(*get_lock());
 
-    // Проверяем, была ли память выделена с использованием текущего аллокатора
-    if (block_to_deallocate_address < _trusted_memory ||
-        block_to_deallocate_address >= reinterpret_cast<unsigned char*>(_trusted_memory) + get_trusted_memory_size())
+    auto* const first_block = get_first_block_address();
+    auto const memory_size = get_trusted_memory_size();
+
+    if (block_to_deallocate_address <= first_block ||
+        block_to_deallocate_address >= first_block + memory_size)
     {
-        // Блок памяти не принадлежит текущему аллокатору
         this->warning_with_guard("Attempt to deallocate memory not allocated by this allocator");
         return;
     }
 
+    auto* block_to_deallocate = get_occupied_block_address(block_to_deallocate_address);
+
+    dump_occupied_block_before_deallocate(block_to_deallocate, get_logger());
+
+    auto block_to_deallocate_size = get_occupied_block_size(block_to_deallocate);
+    auto block_to_deallocate_order = get_block_order(block_to_deallocate_size);
+
+    while (block_to_deallocate_size != memory_size)
+    {
+        // buddies differ only in the bit of their own size within the trusted memory offset
+        auto* const buddy_block = first_block + ((block_to_deallocate - first_block) ^ block_to_deallocate_size);
+
+        if (*reinterpret_cast<size_t*>(buddy_block) != block_to_deallocate_size)
+        {
+            break;
+        }
+
+        this->trace_with_guard("Merging buddy block with target block...");
+        remove_available_block_of_order(buddy_block, block_to_deallocate_order);
+        block_to_deallocate = std::min(block_to_deallocate, buddy_block);
+        block_to_deallocate_size <<= 1;
+        ++block_to_deallocate_order;
+        this->trace_with_guard("Merging completed");
+    }
+
+    insert_available_block_of_order(block_to_deallocate, block_to_deallocate_order);
 
-    // Указатель на размер блока для освобождения памяти
-    auto* block_size_ptr = reinterpret_cast<size_t*>(block_to_deallocate_address) - 1;
+    this->debug_with_guard([&] { return "After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):"; });
+    dump_trusted_memory_blocks_state();
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
 
-    // Устанавливаем флаг блока как "свободный"
-    *block_size_ptr = *block_size_ptr & ~1;
+void* allocator_double_system::reallocate_block(
+    void* block_to_reallocate_address,
+    size_t new_block_size)
+{
+    if (!is_block_size_supported(new_block_size, block_alignment))
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    auto* const first_block = get_first_block_address();
+    auto* const block_to_reallocate = get_occupied_block_address(block_to_reallocate_address);
+    auto const block_to_reallocate_size = get_occupied_block_size(block_to_reallocate);
+    auto const block_to_reallocate_order = get_block_order(block_to_reallocate_size);
+    // aligned data keeps its offset within the block, so the resized block should hold it along with the new size
+    auto const block_data_offset = static_cast<size_t>(reinterpret_cast<unsigned char*>(block_to_reallocate_address) - block_to_reallocate);
+    auto const requested_block_order = std::max(get_block_order(new_block_size + block_data_offset), get_minimal_block_order());
 
-    // Объединяем соседние свободные блоки
-    unsigned char* current_block = reinterpret_cast<unsigned char*>(get_first_available_block_address());
-    unsigned char* previous_block = nullptr;
-    auto block_to_deallocate = reinterpret_cast<unsigned char*>(block_to_deallocate_address);
-    auto block_size = *block_size_ptr;
+    auto resized_block_order = block_to_reallocate_order;
 
-    while (current_block != nullptr)
+    // upper halves of the shrunk block become available; the buddy of each one is the occupied lower half, so none merges
+    while (resized_block_order > requested_block_order)
     {
-        auto current_block_size_ptr = reinterpret_cast<size_t*>(current_block) - 1;
+        --resized_block_order;
+        insert_available_block_of_order(block_to_reallocate + (static_cast<size_t>(1) << resized_block_order), resized_block_order);
+    }
+
+    // grown block takes its buddies while it stays the lower half and the buddy of its order is available
+    if (requested_block_order > block_to_reallocate_order && requested_block_order <= get_block_order(get_trusted_memory_size()))
+    {
+        auto mergeable_block_order = block_to_reallocate_order;
 
-        // Если текущий блок свободен и не является блоком, который мы освобождаем
-        if (((*current_block_size_ptr & 1) == 0) && (current_block != block_to_deallocate))
+        while (mergeable_block_order < requested_block_order)
         {
-            block_size += *current_block_size_ptr;
+            auto const mergeable_block_size = static_cast<size_t>(1) << mergeable_block_order;
 
-            // Удаляем текущий блок из списка свободных блоков
-            if (previous_block == nullptr)
+            if (((block_to_reallocate - first_block) & mergeable_block_size) != 0 ||
+                *reinterpret_cast<size_t*>(block_to_reallocate + mergeable_block_size) != mergeable_block_size)
             {
-                *get_first_available_block_address_address() = reinterpret_cast<void*>(current_block);
+                break;
             }
-            else
+
+            ++mergeable_block_order;
+        }
+
+        if (mergeable_block_order == requested_block_order)
+        {
+            for (; resized_block_order < requested_block_order; ++resized_block_order)
             {
-                *reinterpret_cast<void**>(previous_block) = reinterpret_cast<void*>(current_block);
+                this->trace_with_guard("Merging buddy block with target block...");
+                remove_available_block_of_order(block_to_reallocate + (static_cast<size_t>(1) << resized_block_order), resized_block_order);
             }
-
         }
+    }
 
-        previous_block = current_block;
-        current_block = reinterpret_cast<unsigned char*>(get_available_block_next_available_block_address(current_block));
+    if (resized_block_order == requested_block_order)
+    {
+        auto const resized_block_size = static_cast<size_t>(1) << resized_block_order;
+        *reinterpret_cast<size_t*>(block_to_reallocate) = resized_block_size | block_occupancy_flag;
+        *(reinterpret_cast<size_t*>(block_to_reallocate_address) - 1) = resized_block_size | block_occupancy_flag;
+
+        this->debug_with_guard([&] { return "After `reallocate` in place for " + std::to_string(new_block_size) + " bytes (addr == " +
+            address_to_hex(block_to_reallocate) + "):"; });
+        dump_trusted_memory_blocks_state();
+        return block_to_reallocate_address;
     }
 
-    // Присваиваем объединенный размер блока
-    *block_size_ptr = block_size;
+    // block is moved only when its buddies are taken; it grows then, so the old block holds less data than the new one
+    auto const data_to_move_size = std::min(static_cast<size_t>(block_to_reallocate + block_to_reallocate_size - reinterpret_cast<unsigned char*>(block_to_reallocate_address)), new_block_size);
+    lock.unlock();
 
-    this->debug_with_guard("After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):");
-    dump_trusted_memory_blocks_state();
-    this->trace_with_guard(got_typename + "::deallocate method execution finished");
+    auto* const new_block = allocate_block(new_block_size, block_alignment);
 
+    if (new_block == nullptr)
+    {
+        return nullptr;
+    }
 
+    memcpy(new_block, block_to_reallocate_address, data_to_move_size);
+    deallocate(block_to_reallocate_address);
+    return new_block;
 }
 
 void* allocator_double_system::reallocate(
     void* block_to_reallocate_address,
     size_t new_block_size)
 {
-    auto* new_block = allocate(new_block_size);
-    auto occupied_block_service_block_size = get_occupied_block_service_block_size();
-    auto data_to_move_size = std::min(get_occupied_block_size(reinterpret_cast<unsigned char const*>(new_block) - occupied_block_service_block_size), get_occupied_block_size(reinterpret_cast<unsigned char const*>(block_to_reallocate_address) - occupied_block_service_block_size)) - occupied_block_service_block_size;
-    memcpy(new_block, block_to_reallocate_address, data_to_move_size);
-    deallocate(block_to_reallocate_address);
-    return new_block;
+    auto* const reallocated_block = reallocate_block(block_to_reallocate_address, new_block_size);
+
+    if (reallocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return reallocated_block;
 }
 
 bool allocator_double_system::reallocate(
     void** block_to_reallocate_address_address,
     size_t new_block_size)
 {
-    try {
-        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
-        return true;
-    }
-    catch (std::exception const& ex)
+    auto* const reallocated_block = try_reallocate(*block_to_reallocate_address_address, new_block_size);
+
+    if (reallocated_block == nullptr)
     {
-        this->warning_with_guard(ex.what());
         return false;
     }
+
+    *block_to_reallocate_address_address = reallocated_block;
+    return true;
+}
+
+void* allocator_double_system::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    try
+    {
+        return allocate_block(requested_block_size, block_alignment);
+    }
+    catch (...)
+    {
+        // log messages are built even for the quiet path and may throw
+        return nullptr;
+    }
+}
+
+void* allocator_double_system::try_reallocate(
+    void* block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    try
+    {
+        return reallocate_block(block_to_reallocate_address, new_block_size);
+    }
+    catch (...)
+    {
+        // log messages are built even for the quiet path and may throw
+        return nullptr;
+    }
 }
 
 void allocator_double_system::setup_allocation_mode(
     allocator_fit_allocation::allocation_mode mode)
 {
-    *reinterpret_cast<allocator_fit_allocation::allocation_mode*>(reinterpret_cast<unsigned char*>(_trusted_memory) + sizeof(size_t) + sizeof(allocator*) + sizeof(logger*)) = mode;
+    throw_if_next_fit_requested(mode, get_logger());
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    reinterpret_cast<trusted_memory_header*>(_trusted_memory)->allocation_mode = mode;
+}
+
+spinlock* allocator_double_system::get_lock() const noexcept
+{
+    return &reinterpret_cast<trusted_memory_header*>(_trusted_memory)->lock;
 }
 
 logger* allocator_double_system::get_logger() const noexcept
 {
-    return *reinterpret_cast<logger**>(reinterpret_cast<allocator**>(reinterpret_cast<size_t*>(_trusted_memory) + 1) + 1);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->logger;
 }
 
 std::string allocator_double_system::get_typename() const noexcept
@@ -384,5 +596,5 @@ std::string allocator_double_system::get_typename() const noexcept
 
 allocator* allocator_double_system::get_allocator() const noexcept
 {
-    return *reinterpret_cast<allocator**>(reinterpret_cast<size_t*>(_trusted_memory) + 1);
+    return reinterpret_cast<trusted_memory_header*>(_trusted_memory)->outer_allocator;
 }
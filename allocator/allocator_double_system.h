@@ -7,18 +7,27 @@
 #include "allocator.h"
 #include "allocator_fit_allocation.h"
 #include "allocator_holder.h"
+#include "spinlock.h"
 
 class allocator_double_system final :
-    public allocator_fit_allocation,
-    protected logger_holder,
-    protected typename_holder,
-    protected allocator_holder
+    public allocator_fit_allocation
 {
 
 private:
 
     void* _trusted_memory;
 
+private:
+
+    static constexpr size_t orders_count = sizeof(size_t) * 8;
+
+    static constexpr size_t block_occupancy_flag = 1;
+
+    // trusted memory: [header][free lists occupancy bitmap][free lists][padding][blocks...]
+    static constexpr size_t free_lists_occupancy_bitmap_offset = sizeof(trusted_memory_header);
+
+    static constexpr size_t first_block_offset = get_first_block_offset(free_lists_occupancy_bitmap_offset + sizeof(size_t) + orders_count * sizeof(void*));
+
 public:
 
     explicit allocator_double_system(
@@ -47,13 +56,15 @@ private:
 
     [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
 
-    [[nodiscard]] void** get_first_available_block_address_address() const noexcept override;
-
-    [[nodiscard]] void* get_first_available_block_address() const noexcept override;
+    [[nodiscard]] bool get_block_occupancy(
+        void const* block_pointer) const override;
 
     size_t get_available_block_size(
         void const* current_block_address) const override;
 
+    void* get_available_block_previous_available_block_address(
+        void const* current_block_address) const override;
+
     void* get_available_block_next_available_block_address(
         void const* current_block_address) const override;
 
@@ -62,7 +73,42 @@ private:
 
     void dump_trusted_memory_blocks_state() const override;
 
+private:
+
+    [[nodiscard]] spinlock* get_lock() const noexcept;
+
+    [[nodiscard]] size_t* get_free_lists_occupancy_bitmap_address() const noexcept;
+
+    [[nodiscard]] void** get_free_lists_address() const noexcept;
 
+    [[nodiscard]] unsigned char* get_first_block_address() const noexcept;
+
+    [[nodiscard]] size_t get_minimal_block_order() const noexcept;
+
+    [[nodiscard]] static size_t get_block_order(
+        size_t block_size) noexcept;
+
+    void insert_available_block_of_order(
+        void* block_address,
+        size_t block_order);
+
+    void remove_available_block_of_order(
+        void* block_address,
+        size_t block_order);
+
+    [[nodiscard]] unsigned char* get_occupied_block_address(
+        void const* block_data_address) const;
+
+    // returns nullptr if there is no memory available to allocate
+    [[nodiscard]] void* allocate_block(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    // keeps the block when its order is kept, gives upper halves back when it shrinks and takes available buddies
+    // when it grows; returns nullptr if the block should be moved and there is no memory available to move it to
+    [[nodiscard]] void* reallocate_block(
+        void* block_to_reallocate_address,
+        size_t new_block_size);
 
 public:
 
@@ -80,6 +126,17 @@ public:
         void** block_to_reallocate_address_address,
         size_t new_block_size) override;
 
+    [[nodiscard]] void* allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    [[nodiscard]] void* try_allocate(
+        size_t requested_block_size) noexcept override;
+
+    [[nodiscard]] void* try_reallocate(
+        void* block_to_reallocate_address,
+        size_t new_block_size) noexcept override;
+
 public:
 
     void setup_allocation_mode(
@@ -0,0 +1,390 @@
+#include <algorithm>
+#include "not_implemented.h"
+#include "allocator_fit_allocation.h"
+#include "operation_not_supported.h"
+
+void allocator_fit_allocation::setup_growth(
+    size_t,
+    size_t)
+{
+    throw operation_not_supported();
+}
+
+void allocator_fit_allocation::throw_if_next_fit_requested(
+    allocation_mode mode,
+    ::logger *logger)
+{
+    if (mode != allocation_mode::next_fit)
+    {
+        return;
+    }
+
+    if (logger != nullptr)
+    {
+        logger->warning("next fit allocation mode is not supported by this allocator");
+    }
+
+    throw operation_not_supported();
+}
+
+void allocator_fit_allocation::initialize_growth_service_block(
+    void *growth_service_block_address) noexcept
+{
+    setup_growth_service_block(growth_service_block_address, 0, 0);
+    *reinterpret_cast<void **>(reinterpret_cast<size_t *>(growth_service_block_address) + 2) = nullptr;
+}
+
+void allocator_fit_allocation::setup_growth_service_block(
+    void *growth_service_block_address,
+    size_t chunk_size,
+    size_t free_chunks_high_water_mark) noexcept
+{
+    auto * const chunk_size_space = reinterpret_cast<size_t *>(growth_service_block_address);
+    *chunk_size_space = get_aligned_block_size(chunk_size);
+    *(chunk_size_space + 1) = free_chunks_high_water_mark;
+}
+
+size_t allocator_fit_allocation::get_growth_chunk_size(
+    void const *growth_service_block_address) noexcept
+{
+    return *reinterpret_cast<size_t const *>(growth_service_block_address);
+}
+
+size_t allocator_fit_allocation::get_grown_chunk_size(
+    void const *growth_service_block_address,
+    size_t block_size) noexcept
+{
+    auto const chunk_blocks_size = std::max(get_growth_chunk_size(growth_service_block_address), get_aligned_block_size(block_size));
+    auto const fence_block_size = sizeof(size_t);
+
+    return chunk_service_block_size + chunk_blocks_size + fence_block_size;
+}
+
+size_t allocator_fit_allocation::get_chunk_blocks_size(
+    void const *chunk_address) noexcept
+{
+    return *reinterpret_cast<size_t const *>(reinterpret_cast<void * const *>(chunk_address) + 1);
+}
+
+void *allocator_fit_allocation::link_chunk(
+    void *growth_service_block_address,
+    void *chunk_address,
+    size_t chunk_size) noexcept
+{
+    auto * const first_chunk_address_address = reinterpret_cast<void **>(reinterpret_cast<size_t *>(growth_service_block_address) + 2);
+    auto const chunk_blocks_size = chunk_size - chunk_service_block_size - sizeof(size_t);
+
+    auto * const next_chunk_address_space = reinterpret_cast<void **>(chunk_address);
+    *next_chunk_address_space = *first_chunk_address_address;
+    *first_chunk_address_address = chunk_address;
+
+    auto * const chunk_blocks_size_space = reinterpret_cast<size_t *>(next_chunk_address_space + 1);
+    *chunk_blocks_size_space = chunk_blocks_size;
+
+    // chunk gets the same fences as trusted memory, so neighbours lookup never leaves it
+    auto * const first_block = reinterpret_cast<unsigned char *>(chunk_address) + chunk_service_block_size;
+    *(reinterpret_cast<size_t *>(first_block) - 1) = chunk_fence;
+    *reinterpret_cast<size_t *>(first_block + chunk_blocks_size) = chunk_fence;
+
+    return first_block;
+}
+
+void *allocator_fit_allocation::unlink_first_chunk(
+    void *growth_service_block_address) noexcept
+{
+    auto * const first_chunk_address_address = reinterpret_cast<void **>(reinterpret_cast<size_t *>(growth_service_block_address) + 2);
+    auto * const chunk = *first_chunk_address_address;
+
+    if (chunk != nullptr)
+    {
+        *first_chunk_address_address = *reinterpret_cast<void **>(chunk);
+    }
+
+    return chunk;
+}
+
+void *allocator_fit_allocation::unlink_released_chunk(
+    void *growth_service_block_address,
+    void const *block_address,
+    size_t block_size) const
+{
+    if (growth_service_block_address == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto * const first_chunk_address_address = reinterpret_cast<void **>(reinterpret_cast<size_t *>(growth_service_block_address) + 2);
+    auto const free_chunks_high_water_mark = *(reinterpret_cast<size_t const *>(growth_service_block_address) + 1);
+    auto const * const next_block = reinterpret_cast<unsigned char const *>(block_address) + block_size;
+
+    // only a block ending at the fence may take the whole chunk, so chunks are not walked on every deallocation
+    if (*first_chunk_address_address == nullptr || !get_block_occupancy(next_block) || get_occupied_block_size(next_block) != 0)
+    {
+        return nullptr;
+    }
+
+    void **released_chunk_address_address = nullptr;
+    size_t available_chunks_count = 0;
+
+    for (auto **chunk_address_address = first_chunk_address_address; *chunk_address_address != nullptr; chunk_address_address = reinterpret_cast<void **>(*chunk_address_address))
+    {
+        auto * const chunk = *chunk_address_address;
+        auto const chunk_blocks_size = get_chunk_blocks_size(chunk);
+        auto const * const first_block = reinterpret_cast<unsigned char const *>(chunk) + chunk_service_block_size;
+
+        if (first_block == block_address)
+        {
+            if (chunk_blocks_size == block_size)
+            {
+                released_chunk_address_address = chunk_address_address;
+            }
+        }
+        else if (!get_block_occupancy(first_block) && get_available_block_size(first_block) == chunk_blocks_size)
+        {
+            ++available_chunks_count;
+        }
+    }
+
+    if (released_chunk_address_address == nullptr || available_chunks_count < free_chunks_high_water_mark)
+    {
+        return nullptr;
+    }
+
+    auto * const released_chunk = *released_chunk_address_address;
+    *released_chunk_address_address = *reinterpret_cast<void **>(released_chunk);
+
+    return released_chunk;
+}
+
+void *allocator_fit_allocation::get_growth_service_block_address() const noexcept
+{
+    return nullptr;
+}
+
+void allocator_fit_allocation::insert_available_block(
+    void *,
+    size_t)
+{
+    throw not_implemented("void allocator_fit_allocation::insert_available_block(void *, size_t)");
+}
+
+void allocator_fit_allocation::release_chunk(
+    void *chunk_address) const
+{
+    this->debug_with_guard([&] { return "Released chunk placed at " + address_to_hex(chunk_address); });
+    deallocate_aligned_with_guard(chunk_address, block_alignment);
+}
+
+void allocator_fit_allocation::release_chunks() const noexcept
+{
+    auto * const growth_service_block = get_growth_service_block_address();
+
+    if (growth_service_block == nullptr)
+    {
+        return;
+    }
+
+    for (auto *chunk = unlink_first_chunk(growth_service_block); chunk != nullptr; chunk = unlink_first_chunk(growth_service_block))
+    {
+        deallocate_aligned_with_guard(chunk, block_alignment);
+    }
+}
+
+void *allocator_fit_allocation::find_available_block(
+    size_t) const
+{
+    throw not_implemented("void *allocator_fit_allocation::find_available_block(size_t) const");
+}
+
+void allocator_fit_allocation::remove_available_block(
+    void *)
+{
+    throw not_implemented("void allocator_fit_allocation::remove_available_block(void *)");
+}
+
+void *allocator_fit_allocation::allocate_block(
+    size_t,
+    size_t)
+{
+    throw not_implemented("void *allocator_fit_allocation::allocate_block(size_t, size_t)");
+}
+
+void allocator_fit_allocation::set_occupied_block_size(
+    void *,
+    size_t)
+{
+    throw not_implemented("void allocator_fit_allocation::set_occupied_block_size(void *, size_t)");
+}
+
+size_t allocator_fit_allocation::get_previous_available_block_size(
+    void const *) const
+{
+    throw not_implemented("size_t allocator_fit_allocation::get_previous_available_block_size(void const *) const");
+}
+
+size_t allocator_fit_allocation::get_block_alignment() const noexcept
+{
+    return block_alignment;
+}
+
+void **allocator_fit_allocation::get_next_fit_rover_address_address() const noexcept
+{
+    return nullptr;
+}
+
+void allocator_fit_allocation::unlink_released_block(
+    void const *)
+{
+
+}
+
+void allocator_fit_allocation::relink_moved_block(
+    void const *,
+    void *)
+{
+
+}
+
+size_t allocator_fit_allocation::get_fitting_block_size(
+    size_t requested_block_size) const
+{
+    // block alignment is a power of 2
+    auto const alignment_mask = get_block_alignment() - 1;
+    auto const block_size = (requested_block_size + get_occupied_block_service_block_size() + alignment_mask) & ~alignment_mask;
+
+    return std::max(block_size, get_minimal_available_block_size());
+}
+
+size_t allocator_fit_allocation::get_minimal_available_block_size() const
+{
+    auto const alignment_mask = get_block_alignment() - 1;
+
+    // block left available after a split should hold its service block
+    return (get_available_block_service_block_size() + alignment_mask) & ~alignment_mask;
+}
+
+bool allocator_fit_allocation::resize_block(
+    void *block_address,
+    size_t new_block_size)
+{
+    auto const minimal_available_block_size = get_minimal_available_block_size();
+    auto const new_block_size_overridden = get_fitting_block_size(new_block_size);
+
+    auto const block_size = get_occupied_block_size(block_address);
+    auto * const next_block = reinterpret_cast<unsigned char *>(block_address) + block_size;
+    auto const next_block_size = get_block_occupancy(next_block)
+        ? 0
+        : get_available_block_size(next_block);
+
+    if (new_block_size_overridden > block_size + next_block_size)
+    {
+        return false;
+    }
+
+    auto const remaining_block_size = block_size + next_block_size - new_block_size_overridden;
+
+    // tail too small to be an available block stays inside of the shrunk block
+    if (remaining_block_size < minimal_available_block_size && new_block_size_overridden <= block_size)
+    {
+        return true;
+    }
+
+    if (next_block_size != 0)
+    {
+        remove_available_block(next_block);
+    }
+
+    if (remaining_block_size < minimal_available_block_size)
+    {
+        set_occupied_block_size(block_address, block_size + next_block_size);
+    }
+    else
+    {
+        set_occupied_block_size(block_address, new_block_size_overridden);
+        insert_available_block(reinterpret_cast<unsigned char *>(block_address) + new_block_size_overridden, remaining_block_size);
+    }
+
+    return true;
+}
+
+size_t allocator_fit_allocation::carve_available_block(
+    void *available_block_address,
+    size_t block_size,
+    size_t blocks_count,
+    void **carved_blocks_addresses)
+{
+    auto const minimal_available_block_size = get_minimal_available_block_size();
+
+    auto *target_block = reinterpret_cast<unsigned char *>(available_block_address);
+    auto target_block_size = get_available_block_size(target_block);
+    remove_available_block(target_block);
+
+    size_t carved_blocks_count = 0;
+
+    while (carved_blocks_count < blocks_count && target_block_size >= block_size)
+    {
+        auto const carved_block_size = target_block_size - block_size < minimal_available_block_size
+            ? target_block_size
+            : block_size;
+
+        set_occupied_block_size(target_block, carved_block_size);
+
+        carved_blocks_addresses[carved_blocks_count++] = target_block + sizeof(size_t);
+        target_block += carved_block_size;
+        target_block_size -= carved_block_size;
+    }
+
+    if (target_block_size != 0)
+    {
+        insert_available_block(target_block, target_block_size);
+
+        auto * const next_fit_rover_address_address = get_next_fit_rover_address_address();
+        if (next_fit_rover_address_address != nullptr)
+        {
+            *next_fit_rover_address_address = target_block;
+        }
+    }
+
+    return carved_blocks_count;
+}
+
+void *allocator_fit_allocation::deallocate_adjacent_blocks(
+    void * const *sorted_blocks_addresses,
+    size_t blocks_count,
+    size_t &deallocated_blocks_count)
+{
+    auto *block_to_deallocate = reinterpret_cast<unsigned char *>(sorted_blocks_addresses[0]) - sizeof(size_t);
+    size_t block_to_deallocate_size = 0;
+
+    for (deallocated_blocks_count = 0; deallocated_blocks_count < blocks_count && reinterpret_cast<unsigned char *>(sorted_blocks_addresses[deallocated_blocks_count]) - sizeof(size_t) == block_to_deallocate + block_to_deallocate_size; deallocated_blocks_count++)
+    {
+        unlink_released_block(sorted_blocks_addresses[deallocated_blocks_count]);
+        dump_occupied_block_before_deallocate(block_to_deallocate + block_to_deallocate_size, get_logger());
+        block_to_deallocate_size += get_occupied_block_size(block_to_deallocate + block_to_deallocate_size);
+    }
+
+    auto * const next_block = block_to_deallocate + block_to_deallocate_size;
+    auto const previous_available_block_size = get_previous_available_block_size(block_to_deallocate);
+
+    if (previous_available_block_size != 0)
+    {
+        block_to_deallocate -= previous_available_block_size;
+        block_to_deallocate_size += previous_available_block_size;
+        remove_available_block(block_to_deallocate);
+    }
+
+    if (!get_block_occupancy(next_block))
+    {
+        block_to_deallocate_size += get_available_block_size(next_block);
+        remove_available_block(next_block);
+    }
+
+    auto * const released_chunk = unlink_released_chunk(get_growth_service_block_address(), block_to_deallocate, block_to_deallocate_size);
+
+    if (released_chunk == nullptr)
+    {
+        insert_available_block(block_to_deallocate, block_to_deallocate_size);
+    }
+
+    return released_chunk;
+}
@@ -1,10 +1,24 @@
 #ifndef DATA_STRUCTURES_CPP_MEMORY_WITH_FIT_ALLOCATION_H
 #define DATA_STRUCTURES_CPP_MEMORY_WITH_FIT_ALLOCATION_H
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+#include "typename_holder.h"
+#include "logger_holder.h"
 #include "allocator.h"
+#include "allocator_holder.h"
+#include "spinlock.h"
 
 class allocator_fit_allocation:
-    public allocator
+    public allocator,
+    protected logger_holder,
+    protected typename_holder,
+    protected allocator_holder
 {
 
 public:
@@ -13,7 +27,10 @@ public:
     {
         first_fit,
         the_best_fit,
-        the_worst_fit
+        the_worst_fit,
+        // resumes the search from where the previous one stopped; only engines keeping a list of available blocks
+        // (allocator_sorted_list, allocator_descriptor) serve it, others throw operation_not_supported
+        next_fit
     };
 
 public:
@@ -30,6 +47,77 @@ public:
     allocator_fit_allocation &operator=(
         allocator_fit_allocation &&) noexcept = delete;
 
+public:
+
+    // every in-process fit engine and basic_fit_allocator start trusted memory with this header; trusted memory is
+    // allocated aligned to cache line and fields used by every call come first, so engine's own hot fields placed
+    // right after the header share it
+    template<
+        typename lockable>
+    struct basic_trusted_memory_header
+    {
+
+        lockable lock;
+
+        allocator_fit_allocation::allocation_mode allocation_mode;
+
+        // position next fit search resumes from; its meaning is up to the engine, nullptr means the start
+        void *next_fit_rover;
+
+        ::logger *logger;
+
+        size_t memory_size;
+
+        allocator *outer_allocator;
+
+    };
+
+    static constexpr size_t cache_line_size = 64;
+
+    // block sizes are kept multiple of block alignment and blocks are placed so that data following their header is
+    // aligned to it
+    static constexpr size_t block_alignment = 16;
+
+    // requested sizes and alignments above it would wrap around once service blocks, alignment padding and rounding
+    // are added to them; no trusted memory or chunk could hold such a block anyway
+    static constexpr size_t block_size_limit = std::numeric_limits<size_t>::max() / 4;
+
+public:
+
+    [[nodiscard]] static constexpr size_t get_aligned_block_size(
+        size_t block_size) noexcept
+    {
+        return (block_size + block_alignment - 1) / block_alignment * block_alignment;
+    }
+
+    [[nodiscard]] static constexpr bool is_block_size_supported(
+        size_t requested_block_size,
+        size_t alignment) noexcept
+    {
+        return requested_block_size <= block_size_limit && alignment <= block_size_limit;
+    }
+
+    // offset from trusted memory start to the first block placed after service fields of given size
+    [[nodiscard]] static constexpr size_t get_first_block_offset(
+        size_t service_fields_size,
+        size_t block_header_size = sizeof(size_t)) noexcept
+    {
+        return get_aligned_block_size(service_fields_size + block_header_size) - block_header_size;
+    }
+
+protected:
+
+    using trusted_memory_header = basic_trusted_memory_header<spinlock>;
+
+    // growth service block: [chunk size][free chunks high water mark][first chunk address]; zero chunk size disables growth
+    static constexpr size_t growth_service_block_size = sizeof(size_t) + sizeof(size_t) + sizeof(void *);
+
+    // chunk: [next chunk address][chunk blocks size][first block previous fence][blocks...][last block next fence]
+    static constexpr size_t chunk_service_block_size = sizeof(void *) + sizeof(size_t) + sizeof(size_t);
+
+    // occupied block of zero size; every fit engine keeps block occupancy in the lowest bit of block size
+    static constexpr size_t chunk_fence = 1;
+
 protected:
 
     allocator_fit_allocation() = default;
@@ -38,11 +126,345 @@ protected:
 
     [[nodiscard]] virtual allocation_mode get_allocation_mode() const = 0;
 
+protected:
+
+    static void initialize_growth_service_block(
+        void *growth_service_block_address) noexcept;
+
+    static void setup_growth_service_block(
+        void *growth_service_block_address,
+        size_t chunk_size,
+        size_t free_chunks_high_water_mark) noexcept;
+
+    [[nodiscard]] static size_t get_growth_chunk_size(
+        void const *growth_service_block_address) noexcept;
+
+    [[nodiscard]] static size_t get_grown_chunk_size(
+        void const *growth_service_block_address,
+        size_t block_size) noexcept;
+
+    [[nodiscard]] static size_t get_chunk_blocks_size(
+        void const *chunk_address) noexcept;
+
+    [[nodiscard]] static void *link_chunk(
+        void *growth_service_block_address,
+        void *chunk_address,
+        size_t chunk_size) noexcept;
+
+    [[nodiscard]] static void *unlink_first_chunk(
+        void *growth_service_block_address) noexcept;
+
+    [[nodiscard]] void *unlink_released_chunk(
+        void *growth_service_block_address,
+        void const *block_address,
+        size_t block_size) const;
+
+protected:
+
+    // engines which never grow keep the defaults: no growth service block, chunks are never requested
+    [[nodiscard]] virtual void *get_growth_service_block_address() const noexcept;
+
+    virtual void insert_available_block(
+        void *block_address,
+        size_t block_size);
+
+protected:
+
+    // requests chunk fitting block of block_size from the outer allocator and makes its blocks available; lock is
+    // released while the outer allocator works. Returns the first block of the chunk or nullptr if growth is disabled
+    template<
+        typename lockable>
+    [[nodiscard]] void *grow(
+        size_t block_size,
+        std::unique_lock<lockable> &lock);
+
+    // chunk unlinked by unlink_released_chunk goes back to the outer allocator; lock should not be held
+    void release_chunk(
+        void *chunk_address) const;
+
+    // every chunk still linked goes back to the outer allocator on destruction
+    void release_chunks() const noexcept;
+
+protected:
+
+    // block layout hooks the batch and reallocation paths below are built on; every block starts with size_t header
+    // holding its size and occupancy, data of occupied block follows the header
+
+    [[nodiscard]] virtual void *find_available_block(
+        size_t block_size) const;
+
+    virtual void remove_available_block(
+        void *block_address);
+
+    // takes the lock itself; returns nullptr if there is no memory available to allocate
+    [[nodiscard]] virtual void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment);
+
+    // marks block occupied, so that its physical neighbours see it occupied too; lock should be held by caller
+    virtual void set_occupied_block_size(
+        void *block_address,
+        size_t block_size);
+
+    // size of the available block placed right before the block, or 0 if that block is occupied
+    [[nodiscard]] virtual size_t get_previous_available_block_size(
+        void const *block_address) const;
+
+    // block sizes are kept multiple of it and blocks are placed aligned to it
+    [[nodiscard]] virtual size_t get_block_alignment() const noexcept;
+
+    // engines which don't serve next fit keep no rover and return nullptr
+    [[nodiscard]] virtual void **get_next_fit_rover_address_address() const noexcept;
+
+    // engines keeping links to user blocks drop the links to the block being released; lock should be held by caller
+    virtual void unlink_released_block(
+        void const *block_to_deallocate_address);
+
+    // engines keeping links to user blocks point them to the moved block; takes the lock itself
+    virtual void relink_moved_block(
+        void const *block_to_reallocate_address,
+        void *reallocated_block_address);
+
+protected:
+
+    // size of the block holding requested_block_size bytes of data, never less than the minimal available block
+    [[nodiscard]] size_t get_fitting_block_size(
+        size_t requested_block_size) const;
+
+    [[nodiscard]] size_t get_minimal_available_block_size() const;
+
+    // shrinks block in place or grows it into the next available block; lock should be held by caller
+    bool resize_block(
+        void *block_address,
+        size_t new_block_size);
+
+    // carves up to blocks_count blocks of block_size one after another from the start of available block and leaves
+    // its rest available; lock should be held by caller. Returns the number of carved blocks
+    size_t carve_available_block(
+        void *available_block_address,
+        size_t block_size,
+        size_t blocks_count,
+        void **carved_blocks_addresses);
+
+    // releases the run of blocks adjacent in memory the sorted addresses start with, merging it with available
+    // neighbours; lock should be held by caller. Returns the chunk to release or nullptr
+    [[nodiscard]] void *deallocate_adjacent_blocks(
+        void * const *sorted_blocks_addresses,
+        size_t blocks_count,
+        size_t &deallocated_blocks_count);
+
+    template<
+        typename lockable>
+    void allocate_batch_blocks(
+        lockable &lock_object,
+        size_t requested_block_size,
+        size_t blocks_count,
+        void **allocated_blocks_addresses);
+
+    template<
+        typename lockable>
+    void deallocate_batch_blocks(
+        lockable &lock_object,
+        void **blocks_to_deallocate_addresses,
+        size_t blocks_count);
+
+    // returns nullptr if block can't be resized in place and there is no memory available to move it
+    template<
+        typename lockable>
+    [[nodiscard]] void *reallocate_block(
+        lockable &lock_object,
+        void *block_to_reallocate_address,
+        size_t new_block_size);
+
+protected:
+
+    // for engines which have no position to resume next fit search from
+    static void throw_if_next_fit_requested(
+        allocation_mode mode,
+        ::logger *logger);
+
 public:
 
     virtual void setup_allocation_mode(
         allocation_mode mode) = 0;
 
+    // chunks of at least chunk_size bytes are requested from the outer allocator once trusted memory is exhausted;
+    // fully available chunks are returned back when more than free_chunks_high_water_mark of them are kept
+    virtual void setup_growth(
+        size_t chunk_size,
+        size_t free_chunks_high_water_mark);
+
 };
 
+template<
+    typename lockable>
+void *allocator_fit_allocation::grow(
+    size_t block_size,
+    std::unique_lock<lockable> &lock)
+{
+    auto * const growth_service_block = get_growth_service_block_address();
+
+    if (growth_service_block == nullptr || get_growth_chunk_size(growth_service_block) == 0)
+    {
+        return nullptr;
+    }
+
+    auto const chunk_size = get_grown_chunk_size(growth_service_block, block_size);
+
+    // outer allocator may take long, requests served by the blocks already available are not held meanwhile
+    lock.unlock();
+    auto * const chunk = allocate_aligned_with_guard(chunk_size, block_alignment);
+    lock.lock();
+
+    this->debug_with_guard([&] { return "Trusted memory grown by chunk of " + std::to_string(chunk_size) + " bytes placed at " + address_to_hex(chunk); });
+
+    auto * const first_block = link_chunk(growth_service_block, chunk, chunk_size);
+    insert_available_block(first_block, get_chunk_blocks_size(chunk));
+
+    return first_block;
+}
+
+template<
+    typename lockable>
+void allocator_fit_allocation::allocate_batch_blocks(
+    lockable &lock_object,
+    size_t requested_block_size,
+    size_t blocks_count,
+    void **allocated_blocks_addresses)
+{
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::allocate_batch(size_t requested_block_size, size_t blocks_count, void **allocated_blocks_addresses)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(blocks_count) + " blocks of " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    if (!is_block_size_supported(requested_block_size, get_block_alignment()))
+    {
+        auto const warning_message = "no memory available to allocate";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void " + get_typename() + "::allocate_batch(size_t requested_block_size, size_t blocks_count, void **allocated_blocks_addresses)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    std::unique_lock<lockable> lock(lock_object);
+
+    auto const block_size = get_fitting_block_size(requested_block_size);
+    size_t allocated_blocks_count = 0;
+
+    while (allocated_blocks_count < blocks_count)
+    {
+        auto *target_block = find_available_block(block_size);
+
+        if (target_block == nullptr)
+        {
+            target_block = grow(block_size, lock);
+        }
+
+        if (target_block == nullptr)
+        {
+            break;
+        }
+
+        allocated_blocks_count += carve_available_block(target_block, block_size, blocks_count - allocated_blocks_count, allocated_blocks_addresses + allocated_blocks_count);
+    }
+
+    this->debug_with_guard([&] { return "After `allocate_batch` for " + std::to_string(allocated_blocks_count) + " blocks of " + std::to_string(block_size) + " bytes:"; });
+    dump_trusted_memory_blocks_state();
+    lock.unlock();
+
+    if (allocated_blocks_count != blocks_count)
+    {
+        deallocate_batch(allocated_blocks_addresses, allocated_blocks_count);
+
+        auto const warning_message = "no memory available to allocate";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void " + get_typename() + "::allocate_batch(size_t requested_block_size, size_t blocks_count, void **allocated_blocks_addresses)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::allocate_batch(size_t requested_block_size, size_t blocks_count, void **allocated_blocks_addresses)` execution finished"; });
+}
+
+template<
+    typename lockable>
+void allocator_fit_allocation::deallocate_batch_blocks(
+    lockable &lock_object,
+    void **blocks_to_deallocate_addresses,
+    size_t blocks_count)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate_batch(void **blocks_to_deallocate_addresses, size_t blocks_count) execution started"; });
+
+    // blocks adjacent in memory are merged together before the neighbouring available blocks are touched
+    std::sort(blocks_to_deallocate_addresses, blocks_to_deallocate_addresses + blocks_count, std::less<void *>());
+
+    std::vector<void *> released_chunks;
+
+    std::unique_lock<lockable> lock(lock_object);
+
+    for (size_t deallocated_blocks_count = 0; deallocated_blocks_count < blocks_count;)
+    {
+        size_t run_blocks_count = 0;
+        auto * const released_chunk = deallocate_adjacent_blocks(blocks_to_deallocate_addresses + deallocated_blocks_count, blocks_count - deallocated_blocks_count, run_blocks_count);
+        deallocated_blocks_count += run_blocks_count;
+
+        if (released_chunk != nullptr)
+        {
+            released_chunks.push_back(released_chunk);
+        }
+    }
+
+    this->debug_with_guard([&] { return "After `deallocate_batch` for " + std::to_string(blocks_count) + " blocks:"; });
+    dump_trusted_memory_blocks_state();
+    lock.unlock();
+
+    for (auto * const released_chunk : released_chunks)
+    {
+        release_chunk(released_chunk);
+    }
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate_batch method execution finished"; });
+}
+
+template<
+    typename lockable>
+void *allocator_fit_allocation::reallocate_block(
+    lockable &lock_object,
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    if (!is_block_size_supported(new_block_size, get_block_alignment()))
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    auto * const block_address = reinterpret_cast<unsigned char *>(block_to_reallocate_address) - sizeof(size_t);
+
+    std::unique_lock<lockable> lock(lock_object);
+
+    if (resize_block(block_address, new_block_size))
+    {
+        this->debug_with_guard([&] { return "After `reallocate` in place for " + std::to_string(new_block_size) + " bytes (addr == " +
+                                   address_to_hex(block_address) + "):"; });
+        dump_trusted_memory_blocks_state();
+        return block_to_reallocate_address;
+    }
+
+    auto const data_to_move_size = get_occupied_block_size(block_address) - get_occupied_block_service_block_size();
+    lock.unlock();
+
+    auto * const new_block = allocate_block(new_block_size, get_block_alignment());
+
+    if (new_block != nullptr)
+    {
+        memcpy(new_block, block_to_reallocate_address, std::min(data_to_move_size, new_block_size));
+        relink_moved_block(block_to_reallocate_address, new_block);
+        deallocate(block_to_reallocate_address);
+    }
+
+    return new_block;
+}
+
 #endif // DATA_STRUCTURES_CPP_MEMORY_WITH_FIT_ALLOCATION_H
@@ -1,3 +1,4 @@
+#include <new>
 #include "allocator_holder.h"
 
 void *allocator_holder::allocate_with_guard(
@@ -19,3 +20,25 @@ void allocator_holder::deallocate_with_guard(
         ? ::operator delete(block_pointer)
         : allocator->deallocate(block_pointer);
 }
+
+void *allocator_holder::allocate_aligned_with_guard(
+    size_t block_size,
+    size_t alignment) const
+{
+    auto *allocator = get_allocator();
+
+    return allocator == nullptr
+        ? ::operator new(block_size, std::align_val_t(alignment))
+        : allocator->allocate_aligned(block_size, alignment);
+}
+
+void allocator_holder::deallocate_aligned_with_guard(
+    void *block_pointer,
+    size_t alignment) const
+{
+    auto *allocator = get_allocator();
+
+    allocator == nullptr
+        ? ::operator delete(block_pointer, std::align_val_t(alignment))
+        : allocator->deallocate(block_pointer);
+}
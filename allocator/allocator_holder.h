@@ -18,6 +18,15 @@ public:
     void deallocate_with_guard(
         void *block_pointer) const;
 
+    [[nodiscard]] void *allocate_aligned_with_guard(
+        size_t size,
+        size_t alignment) const;
+
+    // block should be allocated by allocate_aligned_with_guard with the same alignment
+    void deallocate_aligned_with_guard(
+        void *block_pointer,
+        size_t alignment) const;
+
 protected:
 
     [[nodiscard]] virtual allocator *get_allocator() const noexcept = 0;
@@ -0,0 +1,300 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "allocator_mmap.h"
+
+allocator_mmap::allocator_mmap(
+    allocator_mmap::pages_mode mode,
+    bool populate,
+    logger *log)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started");
+    }
+
+    _trusted_memory = ::operator new(get_allocator_service_block_size());
+
+    auto * const pages_mode_space = reinterpret_cast<pages_mode *>(_trusted_memory);
+    *pages_mode_space = mode;
+
+    auto * const populate_space = reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t));
+    *populate_space = populate ? 1 : 0;
+
+    auto * const logger_pointer_space = reinterpret_cast<logger **>(populate_space + 1);
+    *logger_pointer_space = log;
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_mmap::~allocator_mmap() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    ::operator delete(_trusted_memory);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_mmap::get_allocator_service_block_size() const noexcept
+{
+    auto const pages_mode_size = sizeof(size_t);
+    auto const populate_size = sizeof(size_t);
+    auto const logger_pointer_size = sizeof(logger *);
+
+    return pages_mode_size + populate_size + logger_pointer_size;
+}
+
+size_t allocator_mmap::get_occupied_block_service_block_size() const noexcept
+{
+    // two words keep blocks aligned to 16 bytes
+    auto const mapping_size_size = sizeof(size_t);
+    auto const block_size_size = sizeof(size_t);
+
+    return mapping_size_size + block_size_size;
+}
+
+size_t allocator_mmap::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *(reinterpret_cast<size_t const *>(current_block_address) + 1);
+}
+
+allocator_mmap::pages_mode allocator_mmap::get_pages_mode() const noexcept
+{
+    return *reinterpret_cast<pages_mode *>(_trusted_memory);
+}
+
+bool allocator_mmap::get_populate() const noexcept
+{
+    return *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t)) != 0;
+}
+
+size_t allocator_mmap::get_page_size() const noexcept
+{
+    return get_pages_mode() == pages_mode::regular_pages
+        ? static_cast<size_t>(sysconf(_SC_PAGESIZE))
+        : huge_page_size;
+}
+
+void *allocator_mmap::map(
+    size_t mapping_size,
+    allocator_mmap::pages_mode mode) const
+{
+    auto const populate = get_populate();
+    auto const flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    auto populate_flags = 0;
+
+#ifdef MAP_POPULATE
+    populate_flags = populate ? MAP_POPULATE : 0;
+#endif
+
+    if (mode == pages_mode::regular_pages)
+    {
+        auto * const mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, flags | populate_flags, -1, 0);
+
+        return mapping == MAP_FAILED
+            ? nullptr
+            : mapping;
+    }
+
+#ifdef MAP_HUGETLB
+    if (mode == pages_mode::huge_pages)
+    {
+        auto * const mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, flags | populate_flags | MAP_HUGETLB, -1, 0);
+
+        if (mapping != MAP_FAILED)
+        {
+            return mapping;
+        }
+
+        // no huge pages are reserved in the pool, transparent ones are the best we can get
+        this->warning_with_guard("huge pages mapping failed, falling back to transparent huge pages");
+    }
+#endif
+
+    // kernel can back only huge page aligned ranges with huge pages, so extra huge page is mapped and trimmed;
+    // it is not populated on mapping, as pages faulted before madvise would be regular ones
+    auto * const mapping = mmap(nullptr, mapping_size + huge_page_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    auto const mapping_address = reinterpret_cast<uintptr_t>(mapping);
+    auto const aligned_mapping_address = (mapping_address + huge_page_size - 1) / huge_page_size * huge_page_size;
+    auto * const aligned_mapping = reinterpret_cast<unsigned char *>(aligned_mapping_address);
+
+    if (aligned_mapping_address != mapping_address)
+    {
+        munmap(mapping, aligned_mapping_address - mapping_address);
+    }
+    munmap(aligned_mapping + mapping_size, mapping_address + huge_page_size - aligned_mapping_address);
+
+#ifdef MADV_HUGEPAGE
+    madvise(aligned_mapping, mapping_size, MADV_HUGEPAGE);
+#endif
+
+    if (populate)
+    {
+#ifdef MADV_POPULATE_WRITE
+        if (madvise(aligned_mapping, mapping_size, MADV_POPULATE_WRITE) == 0)
+        {
+            return aligned_mapping;
+        }
+#endif
+        auto const page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+        for (size_t offset = 0; offset < mapping_size; offset += page_size)
+        {
+            aligned_mapping[offset] = 0;
+        }
+    }
+
+    return aligned_mapping;
+}
+
+unsigned char *allocator_mmap::get_mapping_address(
+    void const *block_data_address) const noexcept
+{
+    // header of a block aligned up to the page size still lies on the first page of the mapping
+    auto const page_size = get_page_size();
+    auto const block_address = reinterpret_cast<uintptr_t>(block_data_address) - get_occupied_block_service_block_size();
+
+    return reinterpret_cast<unsigned char *>(block_address / page_size * page_size);
+}
+
+void *allocator_mmap::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+    auto const block_data_offset = std::max(occupied_block_service_block_size, alignment);
+    auto const page_size = get_page_size();
+    auto const mapping_size = (block_data_offset + requested_block_size + page_size - 1) / page_size * page_size;
+
+    auto * const mapping = reinterpret_cast<unsigned char *>(map(mapping_size, get_pages_mode()));
+
+    if (mapping == nullptr)
+    {
+        auto const warning_message = "no memory available to allocate";
+
+        this->warning_with_guard(warning_message);
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const block = reinterpret_cast<size_t *>(mapping + block_data_offset - occupied_block_service_block_size);
+    *block = mapping_size;
+    *(block + 1) = requested_block_size;
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(block) + " in mapping of " + std::to_string(mapping_size) + " bytes"; });
+
+    return block + 2;
+}
+
+void *allocator_mmap::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto * const allocated_block = allocate_block(requested_block_size, sizeof(size_t));
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    return allocated_block;
+}
+
+void allocator_mmap::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    auto * const block = reinterpret_cast<size_t *>(block_to_deallocate_address) - 2;
+
+    munmap(get_mapping_address(block_to_deallocate_address), *block);
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void *allocator_mmap::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    auto * const block = reinterpret_cast<size_t *>(block_to_reallocate_address) - 2;
+
+    // tail of the mapping is already there
+    if (static_cast<size_t>(reinterpret_cast<unsigned char *>(block_to_reallocate_address) - get_mapping_address(block_to_reallocate_address)) + new_block_size <= *block)
+    {
+        *(block + 1) = new_block_size;
+
+        return block_to_reallocate_address;
+    }
+
+    auto * const new_block = allocate(new_block_size);
+    memcpy(new_block, block_to_reallocate_address, std::min(get_occupied_block_size(block), new_block_size));
+    deallocate(block_to_reallocate_address);
+
+    return new_block;
+}
+
+bool allocator_mmap::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    try {
+        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
+        return true;
+    }
+    catch (std::exception const &ex)
+    {
+        this->warning_with_guard(ex.what());
+        return false;
+    }
+}
+
+void *allocator_mmap::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment) || alignment > get_page_size())
+    {
+        auto const warning_message = "alignment should be a power of 2 not GT page size";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate_block(requested_block_size, alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    return allocated_block;
+}
+
+logger *allocator_mmap::get_logger() const noexcept
+{
+    return *reinterpret_cast<logger **>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t) + sizeof(size_t));
+}
+
+std::string allocator_mmap::get_typename() const noexcept
+{
+    return "allocator_mmap";
+}
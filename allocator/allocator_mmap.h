@@ -0,0 +1,108 @@
+#ifndef DATA_STRUCTURES_CPP_ALLOCATOR_MMAP_H
+#define DATA_STRUCTURES_CPP_ALLOCATOR_MMAP_H
+
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+
+// maps every requested block with anonymous mmap and unmaps it on deallocation; intended to be passed as outer
+// allocator to the engines, so large trusted memories are backed by (huge) pages straight from the kernel
+class allocator_mmap final:
+    public allocator,
+    protected logger_holder,
+    protected typename_holder
+{
+
+public:
+
+    enum class pages_mode
+    {
+        regular_pages,
+        transparent_huge_pages,
+        huge_pages
+    };
+
+private:
+
+    static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+private:
+
+    void *_trusted_memory;
+
+public:
+
+    explicit allocator_mmap(
+        pages_mode mode = pages_mode::regular_pages,
+        bool populate = false,
+        logger *logger = nullptr);
+
+    allocator_mmap(
+        allocator_mmap const &other) = delete;
+
+    allocator_mmap &operator=(
+        allocator_mmap const &other) = delete;
+
+    ~allocator_mmap() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    size_t get_occupied_block_size(
+        void const *current_block_address) const override;
+
+private:
+
+    [[nodiscard]] pages_mode get_pages_mode() const noexcept;
+
+    [[nodiscard]] bool get_populate() const noexcept;
+
+    [[nodiscard]] size_t get_page_size() const noexcept;
+
+    [[nodiscard]] void *map(
+        size_t mapping_size,
+        pages_mode mode) const;
+
+    [[nodiscard]] unsigned char *get_mapping_address(
+        void const *block_data_address) const noexcept;
+
+    [[nodiscard]] void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment);
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    // alignment is limited by the page size of the mode
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_ALLOCATOR_MMAP_H
@@ -0,0 +1,747 @@
+#include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "allocator_persistent.h"
+
+allocator_persistent::allocator_persistent(
+    std::string const &file_path,
+    size_t memory_size,
+    logger *log,
+    allocator_fit_allocation::allocation_mode allocation_mode)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("heap file: " + file_path + ", requested memory size: " + std::to_string(memory_size) + " bytes");
+    }
+
+    // there is no room for a rover in the stored file layout
+    throw_if_next_fit_requested(allocation_mode, log);
+
+    // block sizes are kept multiple of sizeof(size_t), so the lowest bit of boundary tags holds block occupancy
+    memory_size = memory_size / sizeof(size_t) * sizeof(size_t);
+
+    _trusted_memory = ::operator new(get_allocator_service_block_size());
+
+    auto * const logger_pointer_space = reinterpret_cast<logger **>(_trusted_memory);
+    *logger_pointer_space = log;
+
+    auto * const allocation_mode_space = reinterpret_cast<allocator_fit_allocation::allocation_mode *>(logger_pointer_space + 1);
+    *allocation_mode_space = allocation_mode;
+
+    auto * const file_pointer_space = reinterpret_cast<unsigned char **>(reinterpret_cast<size_t *>(allocation_mode_space) + 1);
+    *file_pointer_space = nullptr;
+
+    new (get_lock()) spinlock();
+
+    auto const file_service_block_size = get_file_service_block_size();
+    auto const fence_block_size = sizeof(size_t);
+
+    auto const throw_with_error = [this, log, &file_path](
+        std::string const &reason)
+    {
+        auto error_message = "can't use heap file " + file_path + ": " + reason;
+
+        if (log != nullptr)
+        {
+            log->error(error_message);
+        }
+
+        ::operator delete(_trusted_memory);
+
+        throw allocator::memory_exception(error_message);
+    };
+
+    auto const descriptor = open(file_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+
+    if (descriptor == -1)
+    {
+        throw_with_error("open failed");
+    }
+
+    // a second allocator would relink the blocks the first one works with; the lock lasts until the descriptor is closed
+    if (flock(descriptor, LOCK_EX | LOCK_NB) == -1)
+    {
+        auto const is_open_elsewhere = errno == EWOULDBLOCK;
+
+        close(descriptor);
+        throw_with_error(is_open_elsewhere
+            ? "heap file is already open"
+            : "lock failed");
+    }
+
+    struct stat file_status;
+    auto const is_created = fstat(descriptor, &file_status) == 0 && file_status.st_size == 0;
+
+    if (is_created)
+    {
+        auto const minimal_trusted_memory_size = get_available_block_service_block_size();
+
+        if (memory_size < minimal_trusted_memory_size)
+        {
+            close(descriptor);
+            throw_with_error("trusted memory size should be GT " + std::to_string(minimal_trusted_memory_size) + " bytes");
+        }
+
+        if (ftruncate(descriptor, static_cast<off_t>(file_service_block_size + memory_size + fence_block_size)) == -1)
+        {
+            close(descriptor);
+            throw_with_error("resize failed");
+        }
+    }
+    else
+    {
+        size_t stored[2] = { 0, 0 };
+
+        if (fstat(descriptor, &file_status) == -1 ||
+            pread(descriptor, stored, sizeof(stored), 0) != sizeof(stored) ||
+            stored[0] != file_signature ||
+            static_cast<size_t>(file_status.st_size) != file_service_block_size + stored[1] + fence_block_size)
+        {
+            close(descriptor);
+            throw_with_error("not a heap file or heap file is damaged");
+        }
+
+        memory_size = stored[1];
+    }
+
+    auto const mapping_size = file_service_block_size + memory_size + fence_block_size;
+    auto * const mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+        close(descriptor);
+        throw_with_error("mapping failed");
+    }
+
+    *file_pointer_space = reinterpret_cast<unsigned char *>(mapping);
+    *get_file_descriptor_address() = descriptor;
+
+    auto * const signature_space = reinterpret_cast<size_t *>(mapping);
+    auto * const memory_size_space = signature_space + 1;
+
+    if (is_created)
+    {
+        *memory_size_space = memory_size;
+
+        set_link(get_first_available_block_link_address(), nullptr);
+        set_link(get_root_block_link_address(), nullptr);
+
+        // occupied zero-sized footer before the first block and header after the last one stop neighbours lookup
+        auto * const first_block = get_file() + file_service_block_size;
+        *(reinterpret_cast<size_t *>(first_block) - 1) = block_occupancy_flag;
+        *reinterpret_cast<size_t *>(first_block + memory_size) = block_occupancy_flag;
+
+        insert_available_block(first_block, memory_size);
+
+        // signature goes last, so a file left half formatted is never taken for a heap
+        *signature_space = file_signature;
+    }
+    else
+    {
+        this->debug_with_guard([&] { return "Heap of " + std::to_string(memory_size) + " bytes restored from " + file_path; });
+    }
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_persistent::~allocator_persistent() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    // dirty pages of the shared mapping reach the file on unmapping, flush is only needed for durability; closing the
+    // descriptor releases the file lock
+    munmap(get_file(), get_mapping_size());
+    close(*get_file_descriptor_address());
+    ::operator delete(_trusted_memory);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_persistent::get_trusted_memory_size() const noexcept
+{
+    return *(reinterpret_cast<size_t *>(get_file()) + 1);
+}
+
+allocator_fit_allocation::allocation_mode allocator_persistent::get_allocation_mode() const noexcept
+{
+    return *reinterpret_cast<allocator_fit_allocation::allocation_mode *>(reinterpret_cast<logger **>(_trusted_memory) + 1);
+}
+
+size_t allocator_persistent::get_allocator_service_block_size() const noexcept
+{
+    auto const logger_pointer_size = sizeof(logger *);
+    auto const allocation_mode_size = sizeof(size_t);
+    auto const file_pointer_size = sizeof(unsigned char *);
+    auto const file_descriptor_size = sizeof(size_t);
+    auto const lock_size = sizeof(spinlock);
+
+    return logger_pointer_size + allocation_mode_size + file_pointer_size + file_descriptor_size + lock_size;
+}
+
+size_t allocator_persistent::get_available_block_service_block_size() const noexcept
+{
+    auto const current_block_header_size = sizeof(size_t);
+    auto const previous_available_block_link_size = sizeof(std::ptrdiff_t);
+    auto const next_available_block_link_size = sizeof(std::ptrdiff_t);
+    auto const current_block_footer_size = sizeof(size_t);
+
+    return current_block_header_size + previous_available_block_link_size + next_available_block_link_size + current_block_footer_size;
+}
+
+size_t allocator_persistent::get_occupied_block_service_block_size() const noexcept
+{
+    auto const current_block_header_size = sizeof(size_t);
+    auto const current_block_footer_size = sizeof(size_t);
+
+    return current_block_header_size + current_block_footer_size;
+}
+
+void *allocator_persistent::get_first_available_block_address() const noexcept
+{
+    return get_linked_address(get_first_available_block_link_address());
+}
+
+bool allocator_persistent::get_block_occupancy(
+    void const *block_pointer) const
+{
+    return (*reinterpret_cast<size_t const *>(block_pointer) & block_occupancy_flag) != 0;
+}
+
+size_t allocator_persistent::get_available_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address) & ~block_occupancy_flag;
+}
+
+void *allocator_persistent::get_available_block_previous_available_block_address(
+    void const *current_block_address) const
+{
+    return get_linked_address(reinterpret_cast<std::ptrdiff_t const *>(reinterpret_cast<size_t const *>(current_block_address) + 1));
+}
+
+void *allocator_persistent::get_available_block_next_available_block_address(
+    void const *current_block_address) const
+{
+    return get_linked_address(reinterpret_cast<std::ptrdiff_t const *>(reinterpret_cast<size_t const *>(current_block_address) + 1) + 1);
+}
+
+size_t allocator_persistent::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address) & ~block_occupancy_flag;
+}
+
+void allocator_persistent::dump_trusted_memory_blocks_state() const
+{
+    if (!is_enabled_with_guard(logger::severity::debug))
+    {
+        return;
+    }
+
+    std::string to_dump("|");
+    auto * current_block = get_file() + get_file_service_block_size();
+    size_t current_block_size;
+
+    while ((current_block_size = get_occupied_block_size(current_block)) != 0)
+    {
+        to_dump += get_block_occupancy(current_block)
+            ? "occ "
+            : "avl ";
+
+        to_dump += std::to_string(current_block_size) + "|";
+        current_block += current_block_size;
+    }
+
+    this->debug_with_guard([&] { return "Memory state: " + to_dump; });
+}
+
+unsigned char *allocator_persistent::get_file() const noexcept
+{
+    return *reinterpret_cast<unsigned char **>(reinterpret_cast<size_t *>(_trusted_memory) + 2);
+}
+
+int *allocator_persistent::get_file_descriptor_address() const noexcept
+{
+    return reinterpret_cast<int *>(reinterpret_cast<size_t *>(_trusted_memory) + 3);
+}
+
+size_t allocator_persistent::get_file_service_block_size() const noexcept
+{
+    auto const signature_size = sizeof(size_t);
+    auto const memory_size_size = sizeof(size_t);
+    auto const first_available_block_link_size = sizeof(std::ptrdiff_t);
+    auto const root_block_link_size = sizeof(std::ptrdiff_t);
+    auto const first_block_previous_fence_size = sizeof(size_t);
+
+    return signature_size + memory_size_size + first_available_block_link_size + root_block_link_size + first_block_previous_fence_size;
+}
+
+size_t allocator_persistent::get_mapping_size() const noexcept
+{
+    return get_file_service_block_size() + get_trusted_memory_size() + sizeof(size_t);
+}
+
+spinlock *allocator_persistent::get_lock() const noexcept
+{
+    return reinterpret_cast<spinlock *>(reinterpret_cast<size_t *>(_trusted_memory) + 4);
+}
+
+std::ptrdiff_t *allocator_persistent::get_first_available_block_link_address() const noexcept
+{
+    return reinterpret_cast<std::ptrdiff_t *>(reinterpret_cast<size_t *>(get_file()) + 2);
+}
+
+std::ptrdiff_t *allocator_persistent::get_root_block_link_address() const noexcept
+{
+    return get_first_available_block_link_address() + 1;
+}
+
+// links hold the distance from themselves to the linked address, no link can point at itself, so zero stands for null
+void *allocator_persistent::get_linked_address(
+    std::ptrdiff_t const *link_address) noexcept
+{
+    return *link_address == 0
+        ? nullptr
+        : reinterpret_cast<void *>(reinterpret_cast<std::uintptr_t>(link_address) + *link_address);
+}
+
+void allocator_persistent::set_link(
+    std::ptrdiff_t *link_address,
+    void const *linked_address) noexcept
+{
+    *link_address = linked_address == nullptr
+        ? 0
+        : static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(linked_address) - reinterpret_cast<std::uintptr_t>(link_address));
+}
+
+void allocator_persistent::set_block_boundary_tags(
+    void *block_address,
+    size_t block_size,
+    bool block_occupancy) const noexcept
+{
+    auto const boundary_tag = block_occupancy
+        ? block_size | block_occupancy_flag
+        : block_size;
+
+    *reinterpret_cast<size_t *>(block_address) = boundary_tag;
+    *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(block_address) + block_size - sizeof(size_t)) = boundary_tag;
+}
+
+void allocator_persistent::insert_available_block(
+    void *block_address,
+    size_t block_size)
+{
+    set_block_boundary_tags(block_address, block_size, false);
+
+    auto * const next_available_block = get_first_available_block_address();
+
+    auto * const previous_available_block_link_address = reinterpret_cast<std::ptrdiff_t *>(reinterpret_cast<size_t *>(block_address) + 1);
+    set_link(previous_available_block_link_address, nullptr);
+    set_link(previous_available_block_link_address + 1, next_available_block);
+
+    if (next_available_block != nullptr)
+    {
+        set_link(reinterpret_cast<std::ptrdiff_t *>(reinterpret_cast<size_t *>(next_available_block) + 1), block_address);
+    }
+
+    set_link(get_first_available_block_link_address(), block_address);
+}
+
+void allocator_persistent::remove_available_block(
+    void *block_address)
+{
+    auto * const previous_available_block = get_available_block_previous_available_block_address(block_address);
+    auto * const next_available_block = get_available_block_next_available_block_address(block_address);
+
+    set_link(previous_available_block == nullptr
+        ? get_first_available_block_link_address()
+        : reinterpret_cast<std::ptrdiff_t *>(reinterpret_cast<size_t *>(previous_available_block) + 1) + 1, next_available_block);
+
+    if (next_available_block != nullptr)
+    {
+        set_link(reinterpret_cast<std::ptrdiff_t *>(reinterpret_cast<size_t *>(next_available_block) + 1), previous_available_block);
+    }
+}
+
+void *allocator_persistent::find_available_block(
+    size_t block_size) const
+{
+    void *target_block = nullptr;
+    auto const allocation_mode = get_allocation_mode();
+
+    for (auto * current_block = get_first_available_block_address(); current_block != nullptr; current_block = get_available_block_next_available_block_address(current_block))
+    {
+        auto const current_block_size = get_available_block_size(current_block);
+
+        if (current_block_size >= block_size)
+        {
+            if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit ||
+                (allocation_mode == allocator_fit_allocation::allocation_mode::the_best_fit && (target_block == nullptr || current_block_size < get_available_block_size(target_block))) ||
+                (allocation_mode == allocator_fit_allocation::allocation_mode::the_worst_fit && (target_block == nullptr || current_block_size > get_available_block_size(target_block))))
+            {
+                target_block = current_block;
+            }
+
+            if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit)
+            {
+                break;
+            }
+        }
+    }
+
+    return target_block;
+}
+
+void allocator_persistent::set_occupied_block_size(
+    void *block_address,
+    size_t block_size)
+{
+    set_block_boundary_tags(block_address, block_size, true);
+}
+
+size_t allocator_persistent::get_previous_available_block_size(
+    void const *block_address) const
+{
+    auto const previous_block_footer = *(reinterpret_cast<size_t const *>(block_address) - 1);
+
+    return (previous_block_footer & block_occupancy_flag) == 0
+        ? previous_block_footer
+        : 0;
+}
+
+void *allocator_persistent::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!is_block_size_supported(requested_block_size, alignment))
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto const available_block_service_block_size = get_available_block_service_block_size();
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+
+    auto requested_block_size_overridden = (requested_block_size + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+    if (requested_block_size_overridden + occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = available_block_service_block_size - occupied_block_service_block_size;
+    }
+
+    // space skipped to align the block is left available, so it should fit an available block
+    auto const alignment_padding_size = alignment > sizeof(size_t)
+        ? alignment + available_block_service_block_size
+        : 0;
+
+    auto *target_block = find_available_block(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size);
+
+    if (target_block == nullptr)
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    auto target_block_size = get_available_block_size(target_block);
+    remove_available_block(target_block);
+
+    auto const aligned_block_offset = get_aligned_block_offset(target_block, sizeof(size_t), alignment, available_block_service_block_size);
+
+    if (aligned_block_offset != 0)
+    {
+        insert_available_block(target_block, aligned_block_offset);
+        target_block = reinterpret_cast<unsigned char *>(target_block) + aligned_block_offset;
+        target_block_size -= aligned_block_offset;
+    }
+
+    if (target_block_size - requested_block_size_overridden - occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = target_block_size - occupied_block_service_block_size;
+    }
+    else
+    {
+        insert_available_block(reinterpret_cast<unsigned char *>(target_block) + occupied_block_service_block_size + requested_block_size_overridden,
+            target_block_size - occupied_block_service_block_size - requested_block_size_overridden);
+    }
+
+    if (requested_block_size_overridden != requested_block_size)
+    {
+        this->trace_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(requested_block_size_overridden) + " bytes in according to correct work of allocator"; });
+
+        requested_block_size = requested_block_size_overridden;
+    }
+
+    set_block_boundary_tags(target_block, requested_block_size + occupied_block_service_block_size, true);
+
+    auto * const allocated_block = reinterpret_cast<void *>(reinterpret_cast<size_t *>(target_block) + 1);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); });
+
+    this->debug_with_guard([&] { return "After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
+        address_to_hex(target_block) + "):"; });
+    dump_trusted_memory_blocks_state();
+    return allocated_block;
+}
+
+void *allocator_persistent::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto * const allocated_block = allocate_block(requested_block_size, sizeof(size_t));
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+void *allocator_persistent::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
+    {
+        auto const warning_message = "alignment should be a power of 2";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate_block(requested_block_size, alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+void *allocator_persistent::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    try
+    {
+        return allocate_block(requested_block_size, sizeof(size_t));
+    }
+    catch (...)
+    {
+        // log messages are built even for the quiet path and may throw
+        return nullptr;
+    }
+}
+
+void allocator_persistent::allocate_batch(
+    size_t requested_block_size,
+    size_t blocks_count,
+    void **allocated_blocks_addresses)
+{
+    allocate_batch_blocks(*get_lock(), requested_block_size, blocks_count, allocated_blocks_addresses);
+}
+
+void allocator_persistent::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * block_to_deallocate = reinterpret_cast<unsigned char *>(block_to_deallocate_address) - sizeof(size_t);
+
+    dump_occupied_block_before_deallocate(block_to_deallocate, get_logger());
+
+    auto block_to_deallocate_size = get_occupied_block_size(block_to_deallocate);
+    auto * const previous_block_footer = reinterpret_cast<size_t *>(block_to_deallocate) - 1;
+    auto * const next_block = block_to_deallocate + block_to_deallocate_size;
+
+    if ((*previous_block_footer & block_occupancy_flag) == 0)
+    {
+        this->trace_with_guard("Merging previous available block with target block...");
+        block_to_deallocate -= *previous_block_footer;
+        block_to_deallocate_size += *previous_block_footer;
+        remove_available_block(block_to_deallocate);
+        this->trace_with_guard("Merging completed");
+    }
+
+    if (!get_block_occupancy(next_block))
+    {
+        this->trace_with_guard("Merging next available block with target block...");
+        block_to_deallocate_size += get_available_block_size(next_block);
+        remove_available_block(next_block);
+        this->trace_with_guard("Merging completed");
+    }
+
+    insert_available_block(block_to_deallocate, block_to_deallocate_size);
+
+    unlink_released_block(block_to_deallocate_address);
+
+    this->debug_with_guard([&] { return "After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):"; });
+    dump_trusted_memory_blocks_state();
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void allocator_persistent::deallocate_batch(
+    void **blocks_to_deallocate_addresses,
+    size_t blocks_count)
+{
+    deallocate_batch_blocks(*get_lock(), blocks_to_deallocate_addresses, blocks_count);
+}
+
+void *allocator_persistent::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(new_block_size) + " bytes of memory for block placed at " + address_to_hex(block_to_reallocate_address); });
+
+    auto * const reallocated_block = reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+    if (reallocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return reallocated_block;
+}
+
+bool allocator_persistent::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    auto * const reallocated_block = try_reallocate(*block_to_reallocate_address_address, new_block_size);
+
+    if (reallocated_block == nullptr)
+    {
+        return false;
+    }
+
+    *block_to_reallocate_address_address = reallocated_block;
+    return true;
+}
+
+void *allocator_persistent::try_reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    try
+    {
+        return reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+    }
+    catch (...)
+    {
+        // log messages are built even for the quiet path and may throw
+        return nullptr;
+    }
+}
+
+void allocator_persistent::setup_allocation_mode(
+    allocator_fit_allocation::allocation_mode mode)
+{
+    throw_if_next_fit_requested(mode, get_logger());
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    *reinterpret_cast<allocator_fit_allocation::allocation_mode *>(reinterpret_cast<logger **>(_trusted_memory) + 1) = mode;
+}
+
+void *allocator_persistent::get_root() const
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    return get_linked_address(get_root_block_link_address());
+}
+
+void allocator_persistent::setup_root(
+    void *root_block_address)
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    set_link(get_root_block_link_address(), root_block_address);
+}
+
+size_t allocator_persistent::get_block_alignment() const noexcept
+{
+    // heap file layout keeps block sizes multiple of size_t only
+    return sizeof(size_t);
+}
+
+void allocator_persistent::unlink_released_block(
+    void const *block_to_deallocate_address)
+{
+    if (get_linked_address(get_root_block_link_address()) == block_to_deallocate_address)
+    {
+        set_link(get_root_block_link_address(), nullptr);
+    }
+}
+
+void allocator_persistent::relink_moved_block(
+    void const *block_to_reallocate_address,
+    void *reallocated_block_address)
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    if (get_linked_address(get_root_block_link_address()) == block_to_reallocate_address)
+    {
+        set_link(get_root_block_link_address(), reallocated_block_address);
+    }
+}
+
+void allocator_persistent::flush() const
+{
+    if (msync(get_file(), get_mapping_size(), MS_SYNC) == -1)
+    {
+        auto const warning_message = "can't flush heap file";
+
+        this->warning_with_guard(warning_message);
+
+        throw memory_exception(warning_message);
+    }
+}
+
+logger *allocator_persistent::get_logger() const noexcept
+{
+    return *reinterpret_cast<logger **>(_trusted_memory);
+}
+
+std::string allocator_persistent::get_typename() const noexcept
+{
+    return "allocator_persistent";
+}
+
+allocator *allocator_persistent::get_allocator() const noexcept
+{
+    return nullptr;
+}
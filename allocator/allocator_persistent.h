@@ -0,0 +1,203 @@
+#ifndef DATA_STRUCTURES_CPP_ALLOCATOR_PERSISTENT_H
+#define DATA_STRUCTURES_CPP_ALLOCATOR_PERSISTENT_H
+
+#include <string>
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "allocator_fit_allocation.h"
+#include "spinlock.h"
+
+// keeps trusted memory in a shared mapping of a file. Blocks carry boundary tags like allocator_descriptor, but
+// available blocks are linked by offsets from the link itself, so the heap, and data built of offset_ptr inside it,
+// is usable as is when the file is mapped again at another address. The file is locked exclusively while open, so
+// one allocator at a time works with the heap; logger, allocation mode and the lock stay in the process
+class allocator_persistent final:
+    public allocator_fit_allocation
+{
+
+private:
+
+    static constexpr size_t file_signature = 0x7061656870736400;
+
+    static constexpr size_t block_occupancy_flag = 1;
+
+private:
+
+    void *_trusted_memory;
+
+public:
+
+    // existing heap file is opened with its own memory size, memory_size only applies to a new one
+    explicit allocator_persistent(
+        std::string const &file_path,
+        size_t memory_size,
+        logger *logger = nullptr,
+        allocator_fit_allocation::allocation_mode allocation_mode = allocator_fit_allocation::allocation_mode::first_fit);
+
+    allocator_persistent(
+        allocator_persistent const &other) = delete;
+
+    allocator_persistent &operator=(
+        allocator_persistent const &other) = delete;
+
+    ~allocator_persistent() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_trusted_memory_size() const noexcept override;
+
+    [[nodiscard]] allocator_fit_allocation::allocation_mode get_allocation_mode() const noexcept override;
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_available_block_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    [[nodiscard]] void *get_first_available_block_address() const noexcept override;
+
+    [[nodiscard]] bool get_block_occupancy(
+        void const *block_pointer) const override;
+
+    size_t get_available_block_size(
+        void const *current_block_address) const override;
+
+    void *get_available_block_previous_available_block_address(
+        void const *current_block_address) const override;
+
+    void *get_available_block_next_available_block_address(
+        void const *current_block_address) const override;
+
+    size_t get_occupied_block_size(
+        void const *current_block_address) const override;
+
+    void dump_trusted_memory_blocks_state() const override;
+
+private:
+
+    [[nodiscard]] unsigned char *get_file() const noexcept;
+
+    [[nodiscard]] int *get_file_descriptor_address() const noexcept;
+
+    [[nodiscard]] size_t get_file_service_block_size() const noexcept;
+
+    [[nodiscard]] size_t get_mapping_size() const noexcept;
+
+    [[nodiscard]] spinlock *get_lock() const noexcept;
+
+    [[nodiscard]] std::ptrdiff_t *get_first_available_block_link_address() const noexcept;
+
+    [[nodiscard]] std::ptrdiff_t *get_root_block_link_address() const noexcept;
+
+    [[nodiscard]] static void *get_linked_address(
+        std::ptrdiff_t const *link_address) noexcept;
+
+    static void set_link(
+        std::ptrdiff_t *link_address,
+        void const *linked_address) noexcept;
+
+    void set_block_boundary_tags(
+        void *block_address,
+        size_t block_size,
+        bool block_occupancy) const noexcept;
+
+    [[nodiscard]] void *find_available_block(
+        size_t block_size) const override;
+
+    void insert_available_block(
+        void *block_address,
+        size_t block_size) override;
+
+    void remove_available_block(
+        void *block_address) override;
+
+    [[nodiscard]] void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    void set_occupied_block_size(
+        void *block_address,
+        size_t block_size) override;
+
+    [[nodiscard]] size_t get_previous_available_block_size(
+        void const *block_address) const override;
+
+    [[nodiscard]] size_t get_block_alignment() const noexcept override;
+
+    void unlink_released_block(
+        void const *block_to_deallocate_address) override;
+
+    void relink_moved_block(
+        void const *block_to_reallocate_address,
+        void *reallocated_block_address) override;
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    [[nodiscard]] void *try_allocate(
+        size_t requested_block_size) noexcept override;
+
+    [[nodiscard]] void *try_reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) noexcept override;
+
+    void allocate_batch(
+        size_t requested_block_size,
+        size_t blocks_count,
+        void **allocated_blocks_addresses) override;
+
+    void deallocate_batch(
+        void **blocks_to_deallocate_addresses,
+        size_t blocks_count) override;
+
+public:
+
+    void setup_allocation_mode(
+        allocator_fit_allocation::allocation_mode mode) override;
+
+public:
+
+    // root block is the entry point to user data found in the heap after reopening
+    [[nodiscard]] void *get_root() const;
+
+    void setup_root(
+        void *root_block_address);
+
+    // writes mapped pages back to the file synchronously
+    void flush() const;
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+private:
+
+    // trusted memory is the heap file mapping, there is no outer allocator
+    [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_ALLOCATOR_PERSISTENT_H
@@ -0,0 +1,399 @@
+#include <mutex>
+#include "allocator_pool.h"
+
+allocator_pool::allocator_pool(
+    size_t block_size,
+    size_t blocks_per_slab_count,
+    allocator *outer_allocator,
+    logger *log)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested block size: " + std::to_string(block_size) + " bytes, blocks per slab: " + std::to_string(blocks_per_slab_count));
+    }
+
+    if (block_size == 0 || blocks_per_slab_count == 0)
+    {
+        auto error_message = "block size and blocks per slab count should be GT 0";
+
+        if (log != nullptr)
+        {
+            log->error(error_message);
+        }
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    block_size = get_adjusted_block_size(block_size);
+
+    auto const allocator_service_block_size = get_allocator_service_block_size();
+
+    _trusted_memory = outer_allocator == nullptr
+        ? ::operator new(allocator_service_block_size)
+        : outer_allocator->allocate(allocator_service_block_size);
+
+    auto * const block_size_space = reinterpret_cast<size_t *>(_trusted_memory);
+    *block_size_space = block_size;
+
+    auto * const outer_allocator_pointer_space = reinterpret_cast<allocator **>(block_size_space + 1);
+    *outer_allocator_pointer_space = outer_allocator;
+
+    auto * const logger_pointer_space = reinterpret_cast<logger **>(outer_allocator_pointer_space + 1);
+    *logger_pointer_space = log;
+
+    auto * const blocks_per_slab_count_space = reinterpret_cast<size_t *>(logger_pointer_space + 1);
+    *blocks_per_slab_count_space = blocks_per_slab_count;
+
+    new (get_lock()) spinlock();
+
+    *get_first_available_block_address_address() = nullptr;
+    *get_first_slab_address_address() = nullptr;
+    *get_current_slab_untouched_blocks_address_address() = nullptr;
+    *get_current_slab_end_address_address() = nullptr;
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_pool::~allocator_pool() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    auto *current_slab = *get_first_slab_address_address();
+    while (current_slab != nullptr)
+    {
+        auto *next_slab = *reinterpret_cast<void **>(current_slab);
+        deallocate_with_guard(current_slab);
+        current_slab = next_slab;
+    }
+
+    deallocate_with_guard(_trusted_memory);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_pool::get_allocator_service_block_size() const noexcept
+{
+    auto const block_size_size = sizeof(size_t);
+    auto const outer_allocator_pointer_size = sizeof(allocator *);
+    auto const logger_pointer_size = sizeof(logger *);
+    auto const blocks_per_slab_count_size = sizeof(size_t);
+    auto const lock_size = sizeof(spinlock);
+    auto const first_available_block_pointer_size = sizeof(void *);
+    auto const first_slab_pointer_size = sizeof(void *);
+    auto const current_slab_untouched_blocks_pointer_size = sizeof(unsigned char *);
+    auto const current_slab_end_pointer_size = sizeof(unsigned char *);
+
+    return block_size_size + outer_allocator_pointer_size + logger_pointer_size + blocks_per_slab_count_size + lock_size + first_available_block_pointer_size +
+        first_slab_pointer_size + current_slab_untouched_blocks_pointer_size + current_slab_end_pointer_size;
+}
+
+size_t allocator_pool::get_occupied_block_service_block_size() const noexcept
+{
+    return 0;
+}
+
+void **allocator_pool::get_first_available_block_address_address() const noexcept
+{
+    return reinterpret_cast<void **>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t) + sizeof(allocator *) + sizeof(logger *) + sizeof(size_t) + sizeof(spinlock));
+}
+
+void *allocator_pool::get_first_available_block_address() const noexcept
+{
+    return *get_first_available_block_address_address();
+}
+
+void *allocator_pool::get_available_block_next_available_block_address(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<void * const *>(current_block_address);
+}
+
+spinlock *allocator_pool::get_lock() const noexcept
+{
+    return reinterpret_cast<spinlock *>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t) + sizeof(allocator *) + sizeof(logger *) + sizeof(size_t));
+}
+
+size_t allocator_pool::get_block_size() const noexcept
+{
+    return *reinterpret_cast<size_t *>(_trusted_memory);
+}
+
+size_t allocator_pool::get_blocks_per_slab_count() const noexcept
+{
+    return *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t) + sizeof(allocator *) + sizeof(logger *));
+}
+
+size_t allocator_pool::get_block_alignment() const noexcept
+{
+    return get_block_alignment(get_block_size());
+}
+
+size_t allocator_pool::get_slab_service_block_size() const noexcept
+{
+    auto const next_slab_pointer_size = sizeof(void *);
+
+    return next_slab_pointer_size;
+}
+
+void **allocator_pool::get_first_slab_address_address() const noexcept
+{
+    return get_first_available_block_address_address() + 1;
+}
+
+unsigned char **allocator_pool::get_current_slab_untouched_blocks_address_address() const noexcept
+{
+    return reinterpret_cast<unsigned char **>(get_first_slab_address_address() + 1);
+}
+
+unsigned char **allocator_pool::get_current_slab_end_address_address() const noexcept
+{
+    return get_current_slab_untouched_blocks_address_address() + 1;
+}
+
+void allocator_pool::allocate_slab()
+{
+    auto const slab_service_block_size = get_slab_service_block_size();
+    auto const slab_blocks_size = get_block_size() * get_blocks_per_slab_count();
+    // slab is overallocated so its first block, and hence every other one, is placed at block alignment
+    auto const block_alignment = get_block_alignment();
+    auto const slab_padding_size = block_alignment - sizeof(void *);
+
+    this->debug_with_guard([&] { return "Allocating slab of " + std::to_string(slab_service_block_size + slab_padding_size + slab_blocks_size) + " bytes"; });
+
+    auto * const slab = reinterpret_cast<unsigned char *>(allocate_with_guard(slab_service_block_size + slab_padding_size + slab_blocks_size));
+
+    auto * const first_slab_address_address = get_first_slab_address_address();
+    *reinterpret_cast<void **>(slab) = *first_slab_address_address;
+    *first_slab_address_address = slab;
+
+    auto * const first_block = slab + slab_service_block_size + get_aligned_block_offset(slab, slab_service_block_size, block_alignment, 0);
+
+    // blocks of a new slab are handed out in address order instead of being threaded into the available blocks list up front
+    *get_current_slab_untouched_blocks_address_address() = first_block;
+    *get_current_slab_end_address_address() = first_block + slab_blocks_size;
+}
+
+void *allocator_pool::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    if (requested_block_size > get_block_size())
+    {
+        auto const warning_message = "requested block size is GT pool block size";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const first_available_block_address_address = get_first_available_block_address_address();
+    void *allocated_block = *first_available_block_address_address;
+
+    if (allocated_block != nullptr)
+    {
+        *first_available_block_address_address = get_available_block_next_available_block_address(allocated_block);
+    }
+    else
+    {
+        auto * const current_slab_untouched_blocks_address_address = get_current_slab_untouched_blocks_address_address();
+
+        if (*current_slab_untouched_blocks_address_address == *get_current_slab_end_address_address())
+        {
+            allocate_slab();
+        }
+
+        allocated_block = *current_slab_untouched_blocks_address_address;
+        *current_slab_untouched_blocks_address_address += get_block_size();
+    }
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); })
+        ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    return allocated_block;
+}
+
+void allocator_pool::allocate_batch(
+    size_t requested_block_size,
+    size_t blocks_count,
+    void **allocated_blocks_addresses)
+{
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::allocate_batch(size_t requested_block_size, size_t blocks_count, void **allocated_blocks_addresses)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(blocks_count) + " blocks of " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    if (requested_block_size > get_block_size())
+    {
+        auto const warning_message = "requested block size is GT pool block size";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void " + get_typename() + "::allocate_batch(size_t requested_block_size, size_t blocks_count, void **allocated_blocks_addresses)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const first_available_block_address_address = get_first_available_block_address_address();
+    auto * const current_slab_untouched_blocks_address_address = get_current_slab_untouched_blocks_address_address();
+    size_t allocated_blocks_count = 0;
+
+    try
+    {
+        for (; allocated_blocks_count < blocks_count; allocated_blocks_count++)
+        {
+            void *allocated_block = *first_available_block_address_address;
+
+            if (allocated_block != nullptr)
+            {
+                *first_available_block_address_address = get_available_block_next_available_block_address(allocated_block);
+            }
+            else
+            {
+                if (*current_slab_untouched_blocks_address_address == *get_current_slab_end_address_address())
+                {
+                    allocate_slab();
+                }
+
+                allocated_block = *current_slab_untouched_blocks_address_address;
+                *current_slab_untouched_blocks_address_address += get_block_size();
+            }
+
+            allocated_blocks_addresses[allocated_blocks_count] = allocated_block;
+        }
+    }
+    catch (...)
+    {
+        // blocks taken before the slab couldn't be allocated go back to the list
+        while (allocated_blocks_count != 0)
+        {
+            auto * const block_address = allocated_blocks_addresses[--allocated_blocks_count];
+            *reinterpret_cast<void **>(block_address) = *first_available_block_address_address;
+            *first_available_block_address_address = block_address;
+        }
+
+        this->trace_with_guard([&] { return "Method `void " + get_typename() + "::allocate_batch(size_t requested_block_size, size_t blocks_count, void **allocated_blocks_addresses)` execution finished"; });
+
+        throw;
+    }
+
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::allocate_batch(size_t requested_block_size, size_t blocks_count, void **allocated_blocks_addresses)` execution finished"; });
+}
+
+void allocator_pool::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const first_available_block_address_address = get_first_available_block_address_address();
+    *reinterpret_cast<void **>(block_to_deallocate_address) = *first_available_block_address_address;
+    *first_available_block_address_address = block_to_deallocate_address;
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void allocator_pool::deallocate_batch(
+    void **blocks_to_deallocate_addresses,
+    size_t blocks_count)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate_batch(void **blocks_to_deallocate_addresses, size_t blocks_count) execution started"; });
+
+    if (blocks_count != 0)
+    {
+        for (size_t i = 0; i + 1 < blocks_count; i++)
+        {
+            *reinterpret_cast<void **>(blocks_to_deallocate_addresses[i]) = blocks_to_deallocate_addresses[i + 1];
+        }
+
+        std::lock_guard<spinlock> lock(*get_lock());
+
+        auto * const first_available_block_address_address = get_first_available_block_address_address();
+        *reinterpret_cast<void **>(blocks_to_deallocate_addresses[blocks_count - 1]) = *first_available_block_address_address;
+        *first_available_block_address_address = blocks_to_deallocate_addresses[0];
+    }
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate_batch method execution finished"; });
+}
+
+void *allocator_pool::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    if (new_block_size > get_block_size())
+    {
+        auto const warning_message = "requested block size is GT pool block size";
+
+        this->warning_with_guard(warning_message);
+
+        throw memory_exception(warning_message);
+    }
+
+    return block_to_reallocate_address;
+}
+
+void *allocator_pool::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; });
+
+    if (!is_alignment_valid(alignment) || alignment > get_block_alignment())
+    {
+        auto const warning_message = "alignment should be a power of 2 not GT pool block alignment";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate(requested_block_size);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    return allocated_block;
+}
+
+bool allocator_pool::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    try {
+        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
+        return true;
+    }
+    catch (std::exception const &ex)
+    {
+        this->warning_with_guard(ex.what());
+        return false;
+    }
+}
+
+logger *allocator_pool::get_logger() const noexcept
+{
+    return *reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1);
+}
+
+std::string allocator_pool::get_typename() const noexcept
+{
+    return "allocator_pool";
+}
+
+allocator *allocator_pool::get_allocator() const noexcept
+{
+    return *reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1);
+}
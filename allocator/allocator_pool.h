@@ -0,0 +1,143 @@
+#ifndef DATA_STRUCTURES_CPP_MEMORY_WITH_POOL_H
+#define DATA_STRUCTURES_CPP_MEMORY_WITH_POOL_H
+
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "allocator_holder.h"
+#include "spinlock.h"
+
+class allocator_pool final:
+    public allocator,
+    protected logger_holder,
+    protected typename_holder,
+    protected allocator_holder
+{
+
+private:
+
+    void *_trusted_memory;
+
+private:
+
+    static constexpr size_t max_block_alignment = 64;
+
+public:
+
+    explicit allocator_pool(
+        size_t block_size,
+        size_t blocks_per_slab_count,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr);
+
+    allocator_pool(
+        allocator_pool const &other) = delete;
+
+    allocator_pool &operator=(
+        allocator_pool const &other) = delete;
+
+    ~allocator_pool() noexcept;
+
+public:
+
+    // available block keeps only the pointer to the next available block, so any block should be able to hold it
+    [[nodiscard]] static constexpr size_t get_adjusted_block_size(
+        size_t block_size) noexcept
+    {
+        return block_size < sizeof(void *)
+            ? sizeof(void *)
+            : (block_size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    }
+
+    // blocks of a pool are aligned to the largest power of 2 dividing adjusted block size, up to max block alignment
+    [[nodiscard]] static constexpr size_t get_block_alignment(
+        size_t block_size) noexcept
+    {
+        auto const adjusted_block_size = get_adjusted_block_size(block_size);
+        auto const block_alignment = adjusted_block_size & (~adjusted_block_size + 1);
+
+        return block_alignment < max_block_alignment
+            ? block_alignment
+            : max_block_alignment;
+    }
+
+private:
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    [[nodiscard]] void **get_first_available_block_address_address() const noexcept override;
+
+    [[nodiscard]] void *get_first_available_block_address() const noexcept override;
+
+    void *get_available_block_next_available_block_address(
+        void const *current_block_address) const override;
+
+private:
+
+    [[nodiscard]] spinlock *get_lock() const noexcept;
+
+    [[nodiscard]] size_t get_block_size() const noexcept;
+
+    [[nodiscard]] size_t get_blocks_per_slab_count() const noexcept;
+
+    [[nodiscard]] size_t get_block_alignment() const noexcept;
+
+    [[nodiscard]] size_t get_slab_service_block_size() const noexcept;
+
+    [[nodiscard]] void **get_first_slab_address_address() const noexcept;
+
+    [[nodiscard]] unsigned char **get_current_slab_untouched_blocks_address_address() const noexcept;
+
+    [[nodiscard]] unsigned char **get_current_slab_end_address_address() const noexcept;
+
+    void allocate_slab();
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    // blocks are aligned to the largest power of 2 dividing block size, up to max block alignment; stricter alignment can't be served
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    void allocate_batch(
+        size_t requested_block_size,
+        size_t blocks_count,
+        void **allocated_blocks_addresses) override;
+
+    // released blocks are linked into a chain pushed onto the available blocks list at once
+    void deallocate_batch(
+        void **blocks_to_deallocate_addresses,
+        size_t blocks_count) override;
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+private:
+
+    [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_MEMORY_WITH_POOL_H
@@ -0,0 +1,920 @@
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include "allocator_red_black_tree.h"
+
+allocator_red_black_tree::allocator_red_black_tree(
+    size_t memory_size,
+    allocator *outer_allocator,
+    logger *log,
+    allocator_fit_allocation::allocation_mode allocation_mode)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested memory size: " + std::to_string(memory_size) + " bytes");
+    }
+
+    // the tree is ordered by block size, so there is no position next fit search could resume from
+    throw_if_next_fit_requested(allocation_mode, log);
+
+    // block sizes are kept multiple of block alignment, so the lowest bits of block header hold block flags
+    memory_size = memory_size / block_alignment * block_alignment;
+
+    auto const minimal_trusted_memory_size = get_available_block_service_block_size();
+
+    if (memory_size < minimal_trusted_memory_size)
+    {
+        auto error_message = "trusted memory size should be GT " + std::to_string(minimal_trusted_memory_size) + " bytes";
+
+        if (log != nullptr)
+        {
+            log->error(error_message);
+        }
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    auto const allocator_service_block_size = get_allocator_service_block_size();
+    auto const fence_block_size = sizeof(size_t);
+
+    _trusted_memory = outer_allocator == nullptr
+        ? ::operator new(memory_size + allocator_service_block_size + fence_block_size, std::align_val_t(cache_line_size))
+        : outer_allocator->allocate_aligned(memory_size + allocator_service_block_size + fence_block_size, cache_line_size);
+
+    auto * const header = new (_trusted_memory) trusted_memory_header();
+    header->allocation_mode = allocation_mode;
+    header->logger = log;
+    header->memory_size = memory_size;
+    header->outer_allocator = outer_allocator;
+
+    initialize_growth_service_block(get_growth_service_block_address());
+
+    // black sentinel node replaces all null links of the tree
+    auto * const tree_nil = get_tree_nil_address();
+    *reinterpret_cast<size_t *>(tree_nil) = 0;
+    *get_tree_node_parent_address_address(tree_nil) = tree_nil;
+    *get_tree_node_left_child_address_address(tree_nil) = tree_nil;
+    *get_tree_node_right_child_address_address(tree_nil) = tree_nil;
+    *get_tree_root_address_address() = tree_nil;
+
+    // occupied zero-sized footer before the first block and header after the last one stop neighbours lookup
+    auto * const first_block = reinterpret_cast<unsigned char *>(_trusted_memory) + allocator_service_block_size;
+    *(reinterpret_cast<size_t *>(first_block) - 1) = block_occupancy_flag;
+    *reinterpret_cast<size_t *>(first_block + memory_size) = block_occupancy_flag;
+
+    insert_available_block(first_block, memory_size);
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_red_black_tree::~allocator_red_black_tree() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    release_chunks();
+
+    deallocate_aligned_with_guard(_trusted_memory, cache_line_size);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_red_black_tree::get_trusted_memory_size() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->memory_size;
+}
+
+allocator_fit_allocation::allocation_mode allocator_red_black_tree::get_allocation_mode() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->allocation_mode;
+}
+
+size_t allocator_red_black_tree::get_allocator_service_block_size() const noexcept
+{
+    return first_block_offset;
+}
+
+size_t allocator_red_black_tree::get_available_block_service_block_size() const noexcept
+{
+    auto const current_block_header_size = sizeof(size_t);
+    auto const parent_tree_node_pointer_size = sizeof(void *);
+    auto const left_child_tree_node_pointer_size = sizeof(void *);
+    auto const right_child_tree_node_pointer_size = sizeof(void *);
+    auto const current_block_footer_size = sizeof(size_t);
+
+    return current_block_header_size + parent_tree_node_pointer_size + left_child_tree_node_pointer_size + right_child_tree_node_pointer_size + current_block_footer_size;
+}
+
+size_t allocator_red_black_tree::get_occupied_block_service_block_size() const noexcept
+{
+    auto const current_block_header_size = sizeof(size_t);
+    auto const current_block_footer_size = sizeof(size_t);
+
+    return current_block_header_size + current_block_footer_size;
+}
+
+bool allocator_red_black_tree::get_block_occupancy(
+    void const *block_pointer) const
+{
+    return (*reinterpret_cast<size_t const *>(block_pointer) & block_occupancy_flag) != 0;
+}
+
+size_t allocator_red_black_tree::get_available_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address) & ~block_flags_mask;
+}
+
+size_t allocator_red_black_tree::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address) & ~block_flags_mask;
+}
+
+void allocator_red_black_tree::dump_trusted_memory_blocks_state() const
+{
+    if (!is_enabled_with_guard(logger::severity::debug))
+    {
+        return;
+    }
+
+    std::string to_dump("|");
+    auto *current_block = reinterpret_cast<unsigned char *>(_trusted_memory) + get_allocator_service_block_size();
+    size_t current_block_size;
+
+    while ((current_block_size = get_occupied_block_size(current_block)) != 0)
+    {
+        to_dump += get_block_occupancy(current_block)
+            ? "occ "
+            : "avl ";
+
+        to_dump += std::to_string(current_block_size) + "|";
+        current_block += current_block_size;
+    }
+
+    this->debug_with_guard([&] { return "Memory state: " + to_dump; });
+}
+
+void **allocator_red_black_tree::get_tree_root_address_address() const noexcept
+{
+    return reinterpret_cast<void **>(reinterpret_cast<unsigned char *>(_trusted_memory) + tree_root_address_offset);
+}
+
+void *allocator_red_black_tree::get_tree_nil_address() const noexcept
+{
+    return reinterpret_cast<unsigned char *>(_trusted_memory) + tree_nil_offset;
+}
+
+void **allocator_red_black_tree::get_tree_node_parent_address_address(
+    void *tree_node) noexcept
+{
+    return reinterpret_cast<void **>(reinterpret_cast<size_t *>(tree_node) + 1);
+}
+
+void **allocator_red_black_tree::get_tree_node_left_child_address_address(
+    void *tree_node) noexcept
+{
+    return get_tree_node_parent_address_address(tree_node) + 1;
+}
+
+void **allocator_red_black_tree::get_tree_node_right_child_address_address(
+    void *tree_node) noexcept
+{
+    return get_tree_node_parent_address_address(tree_node) + 2;
+}
+
+bool allocator_red_black_tree::is_tree_node_red(
+    void const *tree_node) noexcept
+{
+    return (*reinterpret_cast<size_t const *>(tree_node) & tree_node_red_color_flag) != 0;
+}
+
+void allocator_red_black_tree::set_tree_node_color(
+    void *tree_node,
+    bool is_red) noexcept
+{
+    auto * const tree_node_header = reinterpret_cast<size_t *>(tree_node);
+
+    is_red
+        ? *tree_node_header |= tree_node_red_color_flag
+        : *tree_node_header &= ~tree_node_red_color_flag;
+}
+
+bool allocator_red_black_tree::is_tree_node_less(
+    void const *left_tree_node,
+    void const *right_tree_node) const noexcept
+{
+    auto const left_tree_node_size = get_available_block_size(left_tree_node);
+    auto const right_tree_node_size = get_available_block_size(right_tree_node);
+
+    return left_tree_node_size < right_tree_node_size ||
+        (left_tree_node_size == right_tree_node_size && left_tree_node < right_tree_node);
+}
+
+void allocator_red_black_tree::rotate_tree_node_left(
+    void *tree_node)
+{
+    auto * const tree_nil = get_tree_nil_address();
+    auto * const right_child = *get_tree_node_right_child_address_address(tree_node);
+    auto * const parent = *get_tree_node_parent_address_address(tree_node);
+
+    *get_tree_node_right_child_address_address(tree_node) = *get_tree_node_left_child_address_address(right_child);
+    if (*get_tree_node_left_child_address_address(right_child) != tree_nil)
+    {
+        *get_tree_node_parent_address_address(*get_tree_node_left_child_address_address(right_child)) = tree_node;
+    }
+
+    *get_tree_node_parent_address_address(right_child) = parent;
+    if (parent == tree_nil)
+    {
+        *get_tree_root_address_address() = right_child;
+    }
+    else if (tree_node == *get_tree_node_left_child_address_address(parent))
+    {
+        *get_tree_node_left_child_address_address(parent) = right_child;
+    }
+    else
+    {
+        *get_tree_node_right_child_address_address(parent) = right_child;
+    }
+
+    *get_tree_node_left_child_address_address(right_child) = tree_node;
+    *get_tree_node_parent_address_address(tree_node) = right_child;
+}
+
+void allocator_red_black_tree::rotate_tree_node_right(
+    void *tree_node)
+{
+    auto * const tree_nil = get_tree_nil_address();
+    auto * const left_child = *get_tree_node_left_child_address_address(tree_node);
+    auto * const parent = *get_tree_node_parent_address_address(tree_node);
+
+    *get_tree_node_left_child_address_address(tree_node) = *get_tree_node_right_child_address_address(left_child);
+    if (*get_tree_node_right_child_address_address(left_child) != tree_nil)
+    {
+        *get_tree_node_parent_address_address(*get_tree_node_right_child_address_address(left_child)) = tree_node;
+    }
+
+    *get_tree_node_parent_address_address(left_child) = parent;
+    if (parent == tree_nil)
+    {
+        *get_tree_root_address_address() = left_child;
+    }
+    else if (tree_node == *get_tree_node_right_child_address_address(parent))
+    {
+        *get_tree_node_right_child_address_address(parent) = left_child;
+    }
+    else
+    {
+        *get_tree_node_left_child_address_address(parent) = left_child;
+    }
+
+    *get_tree_node_right_child_address_address(left_child) = tree_node;
+    *get_tree_node_parent_address_address(tree_node) = left_child;
+}
+
+void allocator_red_black_tree::transplant_tree_node(
+    void *tree_node_to_replace,
+    void *replacing_tree_node)
+{
+    auto * const parent = *get_tree_node_parent_address_address(tree_node_to_replace);
+
+    if (parent == get_tree_nil_address())
+    {
+        *get_tree_root_address_address() = replacing_tree_node;
+    }
+    else if (tree_node_to_replace == *get_tree_node_left_child_address_address(parent))
+    {
+        *get_tree_node_left_child_address_address(parent) = replacing_tree_node;
+    }
+    else
+    {
+        *get_tree_node_right_child_address_address(parent) = replacing_tree_node;
+    }
+
+    *get_tree_node_parent_address_address(replacing_tree_node) = parent;
+}
+
+void *allocator_red_black_tree::find_available_block(
+    size_t block_size) const
+{
+    auto * const tree_nil = get_tree_nil_address();
+    auto *current_tree_node = *get_tree_root_address_address();
+    void *target_block = nullptr;
+
+    switch (get_allocation_mode())
+    {
+        // next fit is rejected on setup
+        case allocator_fit_allocation::allocation_mode::next_fit:
+        case allocator_fit_allocation::allocation_mode::first_fit:
+            // the first fitting block met while descending from the root
+            while (current_tree_node != tree_nil && get_available_block_size(current_tree_node) < block_size)
+            {
+                current_tree_node = *get_tree_node_right_child_address_address(current_tree_node);
+            }
+
+            return current_tree_node == tree_nil
+                ? nullptr
+                : current_tree_node;
+
+        case allocator_fit_allocation::allocation_mode::the_best_fit:
+            while (current_tree_node != tree_nil)
+            {
+                if (get_available_block_size(current_tree_node) >= block_size)
+                {
+                    target_block = current_tree_node;
+                    current_tree_node = *get_tree_node_left_child_address_address(current_tree_node);
+                }
+                else
+                {
+                    current_tree_node = *get_tree_node_right_child_address_address(current_tree_node);
+                }
+            }
+
+            return target_block;
+
+        case allocator_fit_allocation::allocation_mode::the_worst_fit:
+            if (current_tree_node == tree_nil)
+            {
+                return nullptr;
+            }
+
+            while (*get_tree_node_right_child_address_address(current_tree_node) != tree_nil)
+            {
+                current_tree_node = *get_tree_node_right_child_address_address(current_tree_node);
+            }
+
+            return get_available_block_size(current_tree_node) >= block_size
+                ? current_tree_node
+                : nullptr;
+    }
+
+    return nullptr;
+}
+
+void allocator_red_black_tree::set_block_boundary_tags(
+    void *block_address,
+    size_t block_size,
+    bool block_occupancy) const noexcept
+{
+    auto const boundary_tag = block_occupancy
+        ? block_size | block_occupancy_flag
+        : block_size;
+
+    *reinterpret_cast<size_t *>(block_address) = boundary_tag;
+    *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(block_address) + block_size - sizeof(size_t)) = boundary_tag;
+}
+
+void allocator_red_black_tree::insert_available_block(
+    void *block_address,
+    size_t block_size)
+{
+    set_block_boundary_tags(block_address, block_size, false);
+
+    auto * const tree_nil = get_tree_nil_address();
+    void *parent = tree_nil;
+
+    for (auto *current_tree_node = *get_tree_root_address_address(); current_tree_node != tree_nil; )
+    {
+        parent = current_tree_node;
+        current_tree_node = is_tree_node_less(block_address, current_tree_node)
+            ? *get_tree_node_left_child_address_address(current_tree_node)
+            : *get_tree_node_right_child_address_address(current_tree_node);
+    }
+
+    *get_tree_node_parent_address_address(block_address) = parent;
+    *get_tree_node_left_child_address_address(block_address) = tree_nil;
+    *get_tree_node_right_child_address_address(block_address) = tree_nil;
+    set_tree_node_color(block_address, true);
+
+    if (parent == tree_nil)
+    {
+        *get_tree_root_address_address() = block_address;
+    }
+    else if (is_tree_node_less(block_address, parent))
+    {
+        *get_tree_node_left_child_address_address(parent) = block_address;
+    }
+    else
+    {
+        *get_tree_node_right_child_address_address(parent) = block_address;
+    }
+
+    auto *tree_node = block_address;
+
+    while (is_tree_node_red(*get_tree_node_parent_address_address(tree_node)))
+    {
+        parent = *get_tree_node_parent_address_address(tree_node);
+        auto * const grandparent = *get_tree_node_parent_address_address(parent);
+
+        if (parent == *get_tree_node_left_child_address_address(grandparent))
+        {
+            auto * const uncle = *get_tree_node_right_child_address_address(grandparent);
+
+            if (is_tree_node_red(uncle))
+            {
+                set_tree_node_color(parent, false);
+                set_tree_node_color(uncle, false);
+                set_tree_node_color(grandparent, true);
+                tree_node = grandparent;
+                continue;
+            }
+
+            if (tree_node == *get_tree_node_right_child_address_address(parent))
+            {
+                tree_node = parent;
+                rotate_tree_node_left(tree_node);
+                parent = *get_tree_node_parent_address_address(tree_node);
+            }
+
+            set_tree_node_color(parent, false);
+            set_tree_node_color(grandparent, true);
+            rotate_tree_node_right(grandparent);
+        }
+        else
+        {
+            auto * const uncle = *get_tree_node_left_child_address_address(grandparent);
+
+            if (is_tree_node_red(uncle))
+            {
+                set_tree_node_color(parent, false);
+                set_tree_node_color(uncle, false);
+                set_tree_node_color(grandparent, true);
+                tree_node = grandparent;
+                continue;
+            }
+
+            if (tree_node == *get_tree_node_left_child_address_address(parent))
+            {
+                tree_node = parent;
+                rotate_tree_node_right(tree_node);
+                parent = *get_tree_node_parent_address_address(tree_node);
+            }
+
+            set_tree_node_color(parent, false);
+            set_tree_node_color(grandparent, true);
+            rotate_tree_node_left(grandparent);
+        }
+    }
+
+    set_tree_node_color(*get_tree_root_address_address(), false);
+}
+
+void allocator_red_black_tree::remove_available_block(
+    void *block_address)
+{
+    auto * const tree_nil = get_tree_nil_address();
+    auto *removed_tree_node = block_address;
+    auto removed_tree_node_was_red = is_tree_node_red(removed_tree_node);
+    void *replacing_tree_node;
+
+    if (*get_tree_node_left_child_address_address(block_address) == tree_nil)
+    {
+        replacing_tree_node = *get_tree_node_right_child_address_address(block_address);
+        transplant_tree_node(block_address, replacing_tree_node);
+    }
+    else if (*get_tree_node_right_child_address_address(block_address) == tree_nil)
+    {
+        replacing_tree_node = *get_tree_node_left_child_address_address(block_address);
+        transplant_tree_node(block_address, replacing_tree_node);
+    }
+    else
+    {
+        // the successor takes the place of removed node
+        removed_tree_node = *get_tree_node_right_child_address_address(block_address);
+        while (*get_tree_node_left_child_address_address(removed_tree_node) != tree_nil)
+        {
+            removed_tree_node = *get_tree_node_left_child_address_address(removed_tree_node);
+        }
+
+        removed_tree_node_was_red = is_tree_node_red(removed_tree_node);
+        replacing_tree_node = *get_tree_node_right_child_address_address(removed_tree_node);
+
+        if (*get_tree_node_parent_address_address(removed_tree_node) == block_address)
+        {
+            *get_tree_node_parent_address_address(replacing_tree_node) = removed_tree_node;
+        }
+        else
+        {
+            transplant_tree_node(removed_tree_node, replacing_tree_node);
+            *get_tree_node_right_child_address_address(removed_tree_node) = *get_tree_node_right_child_address_address(block_address);
+            *get_tree_node_parent_address_address(*get_tree_node_right_child_address_address(removed_tree_node)) = removed_tree_node;
+        }
+
+        transplant_tree_node(block_address, removed_tree_node);
+        *get_tree_node_left_child_address_address(removed_tree_node) = *get_tree_node_left_child_address_address(block_address);
+        *get_tree_node_parent_address_address(*get_tree_node_left_child_address_address(removed_tree_node)) = removed_tree_node;
+        set_tree_node_color(removed_tree_node, is_tree_node_red(block_address));
+    }
+
+    if (removed_tree_node_was_red)
+    {
+        return;
+    }
+
+    auto *tree_node = replacing_tree_node;
+
+    while (tree_node != *get_tree_root_address_address() && !is_tree_node_red(tree_node))
+    {
+        auto * const parent = *get_tree_node_parent_address_address(tree_node);
+
+        if (tree_node == *get_tree_node_left_child_address_address(parent))
+        {
+            auto *sibling = *get_tree_node_right_child_address_address(parent);
+
+            if (is_tree_node_red(sibling))
+            {
+                set_tree_node_color(sibling, false);
+                set_tree_node_color(parent, true);
+                rotate_tree_node_left(parent);
+                sibling = *get_tree_node_right_child_address_address(parent);
+            }
+
+            if (!is_tree_node_red(*get_tree_node_left_child_address_address(sibling)) &&
+                !is_tree_node_red(*get_tree_node_right_child_address_address(sibling)))
+            {
+                set_tree_node_color(sibling, true);
+                tree_node = parent;
+                continue;
+            }
+
+            if (!is_tree_node_red(*get_tree_node_right_child_address_address(sibling)))
+            {
+                set_tree_node_color(*get_tree_node_left_child_address_address(sibling), false);
+                set_tree_node_color(sibling, true);
+                rotate_tree_node_right(sibling);
+                sibling = *get_tree_node_right_child_address_address(parent);
+            }
+
+            set_tree_node_color(sibling, is_tree_node_red(parent));
+            set_tree_node_color(parent, false);
+            set_tree_node_color(*get_tree_node_right_child_address_address(sibling), false);
+            rotate_tree_node_left(parent);
+        }
+        else
+        {
+            auto *sibling = *get_tree_node_left_child_address_address(parent);
+
+            if (is_tree_node_red(sibling))
+            {
+                set_tree_node_color(sibling, false);
+                set_tree_node_color(parent, true);
+                rotate_tree_node_right(parent);
+                sibling = *get_tree_node_left_child_address_address(parent);
+            }
+
+            if (!is_tree_node_red(*get_tree_node_left_child_address_address(sibling)) &&
+                !is_tree_node_red(*get_tree_node_right_child_address_address(sibling)))
+            {
+                set_tree_node_color(sibling, true);
+                tree_node = parent;
+                continue;
+            }
+
+            if (!is_tree_node_red(*get_tree_node_left_child_address_address(sibling)))
+            {
+                set_tree_node_color(*get_tree_node_right_child_address_address(sibling), false);
+                set_tree_node_color(sibling, true);
+                rotate_tree_node_left(sibling);
+                sibling = *get_tree_node_left_child_address_address(parent);
+            }
+
+            set_tree_node_color(sibling, is_tree_node_red(parent));
+            set_tree_node_color(parent, false);
+            set_tree_node_color(*get_tree_node_left_child_address_address(sibling), false);
+            rotate_tree_node_right(parent);
+        }
+
+        tree_node = *get_tree_root_address_address();
+    }
+
+    set_tree_node_color(tree_node, false);
+}
+
+void allocator_red_black_tree::set_occupied_block_size(
+    void *block_address,
+    size_t block_size)
+{
+    set_block_boundary_tags(block_address, block_size, true);
+}
+
+size_t allocator_red_black_tree::get_previous_available_block_size(
+    void const *block_address) const
+{
+    auto const previous_block_footer = *(reinterpret_cast<size_t const *>(block_address) - 1);
+
+    return (previous_block_footer & block_occupancy_flag) == 0
+        ? previous_block_footer
+        : 0;
+}
+
+void *allocator_red_black_tree::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!is_block_size_supported(requested_block_size, alignment))
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    // tree node does not fill a multiple of block alignment, the smallest available block is rounded up
+    auto const available_block_service_block_size = get_aligned_block_size(get_available_block_service_block_size());
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+
+    auto requested_block_size_overridden = get_aligned_block_size(requested_block_size + occupied_block_service_block_size) - occupied_block_service_block_size;
+    if (requested_block_size_overridden + occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = available_block_service_block_size - occupied_block_service_block_size;
+    }
+
+    // space skipped to align the block is left available, so it should fit an available block
+    auto const alignment_padding_size = alignment > block_alignment
+        ? alignment + available_block_service_block_size
+        : 0;
+
+    auto *target_block = find_available_block(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size);
+
+    if (target_block == nullptr)
+    {
+        target_block = grow(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size, lock);
+    }
+
+    if (target_block == nullptr)
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    auto target_block_size = get_available_block_size(target_block);
+    remove_available_block(target_block);
+
+    auto const aligned_block_offset = get_aligned_block_offset(target_block, sizeof(size_t), alignment, available_block_service_block_size);
+
+    if (aligned_block_offset != 0)
+    {
+        insert_available_block(target_block, aligned_block_offset);
+        target_block = reinterpret_cast<unsigned char *>(target_block) + aligned_block_offset;
+        target_block_size -= aligned_block_offset;
+    }
+
+    if (target_block_size - requested_block_size_overridden - occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = target_block_size - occupied_block_service_block_size;
+    }
+    else
+    {
+        insert_available_block(reinterpret_cast<unsigned char *>(target_block) + occupied_block_service_block_size + requested_block_size_overridden,
+            target_block_size - occupied_block_service_block_size - requested_block_size_overridden);
+    }
+
+    if (requested_block_size_overridden != requested_block_size)
+    {
+        this->trace_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(requested_block_size_overridden) + " bytes in according to correct work of allocator"; });
+
+        requested_block_size = requested_block_size_overridden;
+    }
+
+    set_block_boundary_tags(target_block, requested_block_size + occupied_block_service_block_size, true);
+
+    auto * const allocated_block = reinterpret_cast<void *>(reinterpret_cast<size_t *>(target_block) + 1);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); });
+
+    this->debug_with_guard([&] { return "After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
+                               address_to_hex(target_block) + "):"; });
+    dump_trusted_memory_blocks_state();
+    return allocated_block;
+}
+
+void *allocator_red_black_tree::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto * const allocated_block = allocate_block(requested_block_size, block_alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+void *allocator_red_black_tree::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
+    {
+        auto const warning_message = "alignment should be a power of 2";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate_block(requested_block_size, alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+void *allocator_red_black_tree::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    try
+    {
+        return allocate_block(requested_block_size, block_alignment);
+    }
+    catch (...)
+    {
+        // outer allocator may throw while heap grows
+        return nullptr;
+    }
+}
+
+void allocator_red_black_tree::allocate_batch(
+    size_t requested_block_size,
+    size_t blocks_count,
+    void **allocated_blocks_addresses)
+{
+    allocate_batch_blocks(*get_lock(), requested_block_size, blocks_count, allocated_blocks_addresses);
+}
+
+void allocator_red_black_tree::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    auto *block_to_deallocate = reinterpret_cast<unsigned char *>(block_to_deallocate_address) - sizeof(size_t);
+
+    dump_occupied_block_before_deallocate(block_to_deallocate, get_logger());
+
+    auto block_to_deallocate_size = get_occupied_block_size(block_to_deallocate);
+    auto * const previous_block_footer = reinterpret_cast<size_t *>(block_to_deallocate) - 1;
+    auto * const next_block = block_to_deallocate + block_to_deallocate_size;
+
+    if ((*previous_block_footer & block_occupancy_flag) == 0)
+    {
+        this->trace_with_guard("Merging previous available block with target block...");
+        block_to_deallocate -= *previous_block_footer;
+        block_to_deallocate_size += *previous_block_footer;
+        remove_available_block(block_to_deallocate);
+        this->trace_with_guard("Merging completed");
+    }
+
+    if (!get_block_occupancy(next_block))
+    {
+        this->trace_with_guard("Merging next available block with target block...");
+        block_to_deallocate_size += get_available_block_size(next_block);
+        remove_available_block(next_block);
+        this->trace_with_guard("Merging completed");
+    }
+
+    auto * const released_chunk = unlink_released_chunk(get_growth_service_block_address(), block_to_deallocate, block_to_deallocate_size);
+
+    if (released_chunk == nullptr)
+    {
+        insert_available_block(block_to_deallocate, block_to_deallocate_size);
+    }
+
+    this->debug_with_guard([&] { return "After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):"; });
+    dump_trusted_memory_blocks_state();
+    lock.unlock();
+
+    if (released_chunk != nullptr)
+    {
+        release_chunk(released_chunk);
+    }
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void allocator_red_black_tree::deallocate_batch(
+    void **blocks_to_deallocate_addresses,
+    size_t blocks_count)
+{
+    deallocate_batch_blocks(*get_lock(), blocks_to_deallocate_addresses, blocks_count);
+}
+
+void *allocator_red_black_tree::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(new_block_size) + " bytes of memory for block placed at " + address_to_hex(block_to_reallocate_address); });
+
+    auto * const reallocated_block = reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+    if (reallocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return reallocated_block;
+}
+
+bool allocator_red_black_tree::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    auto * const reallocated_block = try_reallocate(*block_to_reallocate_address_address, new_block_size);
+
+    if (reallocated_block == nullptr)
+    {
+        return false;
+    }
+
+    *block_to_reallocate_address_address = reallocated_block;
+    return true;
+}
+
+void *allocator_red_black_tree::try_reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    try
+    {
+        return reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+    }
+    catch (...)
+    {
+        // outer allocator may throw while heap grows
+        return nullptr;
+    }
+}
+
+void allocator_red_black_tree::setup_allocation_mode(
+    allocator_fit_allocation::allocation_mode mode)
+{
+    throw_if_next_fit_requested(mode, get_logger());
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    reinterpret_cast<trusted_memory_header *>(_trusted_memory)->allocation_mode = mode;
+}
+
+void allocator_red_black_tree::setup_growth(
+    size_t chunk_size,
+    size_t free_chunks_high_water_mark)
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    setup_growth_service_block(get_growth_service_block_address(), std::max(chunk_size, get_available_block_service_block_size()), free_chunks_high_water_mark);
+}
+
+spinlock *allocator_red_black_tree::get_lock() const noexcept
+{
+    return &reinterpret_cast<trusted_memory_header *>(_trusted_memory)->lock;
+}
+
+void *allocator_red_black_tree::get_growth_service_block_address() const noexcept
+{
+    return reinterpret_cast<unsigned char *>(_trusted_memory) + growth_service_block_offset;
+}
+
+logger *allocator_red_black_tree::get_logger() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->logger;
+}
+
+std::string allocator_red_black_tree::get_typename() const noexcept
+{
+    return "allocator_red_black_tree";
+}
+
+allocator *allocator_red_black_tree::get_allocator() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->outer_allocator;
+}
@@ -0,0 +1,202 @@
+#ifndef DATA_STRUCTURES_CPP_MEMORY_WITH_RED_BLACK_TREE_H
+#define DATA_STRUCTURES_CPP_MEMORY_WITH_RED_BLACK_TREE_H
+
+#include <mutex>
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "allocator_fit_allocation.h"
+#include "allocator_holder.h"
+#include "spinlock.h"
+
+class allocator_red_black_tree final:
+    public allocator_fit_allocation
+{
+
+private:
+
+    void *_trusted_memory;
+
+private:
+
+    static constexpr size_t block_occupancy_flag = 1;
+
+    static constexpr size_t tree_node_red_color_flag = 2;
+
+    static constexpr size_t block_flags_mask = block_occupancy_flag | tree_node_red_color_flag;
+
+    // trusted memory: [header][tree root address][tree nil][growth service block][padding][first block previous fence][blocks...][last block next fence]
+    static constexpr size_t tree_root_address_offset = sizeof(trusted_memory_header);
+
+    static constexpr size_t tree_nil_offset = tree_root_address_offset + sizeof(void *);
+
+    static constexpr size_t growth_service_block_offset = tree_nil_offset + sizeof(size_t) + 3 * sizeof(void *);
+
+    static constexpr size_t first_block_offset = get_first_block_offset(growth_service_block_offset + growth_service_block_size + sizeof(size_t));
+
+public:
+
+    explicit allocator_red_black_tree(
+        size_t memory_size,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr,
+        allocator_fit_allocation::allocation_mode allocation_mode = allocator_fit_allocation::allocation_mode::first_fit);
+
+    allocator_red_black_tree(
+        allocator_red_black_tree const &other) = delete;
+
+    allocator_red_black_tree &operator=(
+        allocator_red_black_tree const &other) = delete;
+
+    ~allocator_red_black_tree() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_trusted_memory_size() const noexcept override;
+
+    [[nodiscard]] allocator_fit_allocation::allocation_mode get_allocation_mode() const noexcept override;
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_available_block_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    [[nodiscard]] bool get_block_occupancy(
+        void const *block_pointer) const override;
+
+    size_t get_available_block_size(
+        void const *current_block_address) const override;
+
+    size_t get_occupied_block_size(
+        void const *current_block_address) const override;
+
+    void dump_trusted_memory_blocks_state() const override;
+
+private:
+
+    [[nodiscard]] spinlock *get_lock() const noexcept;
+
+    [[nodiscard]] void *get_growth_service_block_address() const noexcept override;
+
+    [[nodiscard]] void **get_tree_root_address_address() const noexcept;
+
+    [[nodiscard]] void *get_tree_nil_address() const noexcept;
+
+    [[nodiscard]] static void **get_tree_node_parent_address_address(
+        void *tree_node) noexcept;
+
+    [[nodiscard]] static void **get_tree_node_left_child_address_address(
+        void *tree_node) noexcept;
+
+    [[nodiscard]] static void **get_tree_node_right_child_address_address(
+        void *tree_node) noexcept;
+
+    [[nodiscard]] static bool is_tree_node_red(
+        void const *tree_node) noexcept;
+
+    static void set_tree_node_color(
+        void *tree_node,
+        bool is_red) noexcept;
+
+    [[nodiscard]] bool is_tree_node_less(
+        void const *left_tree_node,
+        void const *right_tree_node) const noexcept;
+
+    void rotate_tree_node_left(
+        void *tree_node);
+
+    void rotate_tree_node_right(
+        void *tree_node);
+
+    void transplant_tree_node(
+        void *tree_node_to_replace,
+        void *replacing_tree_node);
+
+    [[nodiscard]] void *find_available_block(
+        size_t block_size) const override;
+
+    void set_block_boundary_tags(
+        void *block_address,
+        size_t block_size,
+        bool block_occupancy) const noexcept;
+
+    void insert_available_block(
+        void *block_address,
+        size_t block_size) override;
+
+    void remove_available_block(
+        void *block_address) override;
+
+    [[nodiscard]] void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    void set_occupied_block_size(
+        void *block_address,
+        size_t block_size) override;
+
+    [[nodiscard]] size_t get_previous_available_block_size(
+        void const *block_address) const override;
+
+public:
+
+    void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    [[nodiscard]] void *try_allocate(
+        size_t requested_block_size) noexcept override;
+
+    [[nodiscard]] void *try_reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) noexcept override;
+
+    void allocate_batch(
+        size_t requested_block_size,
+        size_t blocks_count,
+        void **allocated_blocks_addresses) override;
+
+    void deallocate_batch(
+        void **blocks_to_deallocate_addresses,
+        size_t blocks_count) override;
+
+public:
+
+    void setup_allocation_mode(
+        allocator_fit_allocation::allocation_mode mode) override;
+
+    void setup_growth(
+        size_t chunk_size,
+        size_t free_chunks_high_water_mark) override;
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+private:
+
+    [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_MEMORY_WITH_RED_BLACK_TREE_H
@@ -1,413 +1,772 @@
-#include "allocator_sorted_list.h"
-
-allocator_sorted_list::allocator_sorted_list(
-    size_t memory_size,
-    allocator *outer_allocator,
-    logger *log,
-    allocator_fit_allocation::allocation_mode allocation_mode)
-{
-    auto got_typename = get_typename();
-
-    if (log != nullptr)
-    {
-        log->trace(got_typename + " allocator instance construction started")
-            ->debug("requested memory size: " + std::to_string(memory_size) + " bytes");
-    }
-
-    auto const minimal_trusted_memory_size = get_available_block_service_block_size();
-
-    if (memory_size < minimal_trusted_memory_size)
-    {
-        auto error_message = "trusted memory size should be GT " + std::to_string(minimal_trusted_memory_size) + " bytes";
-
-        if (log != nullptr)
-        {
-            log->error(error_message);
-        }
-
-        throw allocator::memory_exception(error_message);
-    }
-
-    auto const allocator_service_block_size = get_allocator_service_block_size();
-
-    _trusted_memory = outer_allocator == nullptr
-        ? ::operator new(memory_size + allocator_service_block_size)
-        : outer_allocator->allocate(memory_size + allocator_service_block_size);
-
-    auto * const memory_size_space = reinterpret_cast<size_t *>(_trusted_memory);
-    *memory_size_space = memory_size;
-
-    auto * const outer_allocator_pointer_space = reinterpret_cast<allocator **>(memory_size_space + 1);
-    *outer_allocator_pointer_space = outer_allocator;
-
-    auto * const logger_pointer_space = reinterpret_cast<logger **>(outer_allocator_pointer_space + 1);
-    *logger_pointer_space = log;
-
-    auto * const allocation_mode_space = reinterpret_cast<allocator_fit_allocation::allocation_mode *>(logger_pointer_space + 1);
-    *allocation_mode_space = allocation_mode;
-
-    auto * const first_available_block_pointer_space = reinterpret_cast<void **>(allocation_mode_space + 1);
-    *first_available_block_pointer_space = reinterpret_cast<void *>(first_available_block_pointer_space + 1);
-
-    auto * const first_available_block_size_space = reinterpret_cast<size_t *>(*first_available_block_pointer_space);
-    *first_available_block_size_space = memory_size;
-
-    auto * const first_available_block_next_block_address_space = reinterpret_cast<void **>(first_available_block_size_space + 1);
-    *first_available_block_next_block_address_space = nullptr;
-
-    this->trace_with_guard(got_typename + " allocator instance construction finished");
-}
-
-allocator_sorted_list::~allocator_sorted_list() noexcept
-{
-    auto got_typename = get_typename();
-    this->trace_with_guard(got_typename + " allocator instance destruction started");
-
-    auto const * const logger = get_logger();
-
-    deallocate_with_guard(_trusted_memory);
-
-    if (logger != nullptr)
-    {
-        logger->trace(got_typename + " allocator instance destruction finished");
-    }
-}
-
-size_t allocator_sorted_list::get_trusted_memory_size() const noexcept
-{
-    return *reinterpret_cast<size_t *>(_trusted_memory);
-}
-
-allocator_fit_allocation::allocation_mode allocator_sorted_list::get_allocation_mode() const noexcept
-{
-    return *reinterpret_cast<allocator_fit_allocation::allocation_mode *>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t) + sizeof(allocator *) + sizeof(logger *));
-}
-
-size_t allocator_sorted_list::get_allocator_service_block_size() const noexcept
-{
-    auto const memory_size_size = sizeof(size_t);
-    auto const outer_allocator_pointer_size = sizeof(allocator *);
-    auto const logger_pointer_size = sizeof(logger *);
-    auto const allocation_mode_size = sizeof(allocator_fit_allocation::allocation_mode);
-    auto const first_available_block_pointer_size = sizeof(void *);
-
-    return memory_size_size + outer_allocator_pointer_size + logger_pointer_size + allocation_mode_size + first_available_block_pointer_size;
-}
-
-size_t allocator_sorted_list::get_available_block_service_block_size() const noexcept
-{
-    auto const current_block_size = sizeof(size_t);
-    auto const next_available_block_pointer_size = sizeof(void *);
-
-    return current_block_size + next_available_block_pointer_size;
-}
-
-size_t allocator_sorted_list::get_occupied_block_service_block_size() const noexcept
-{
-    auto const current_block_size = sizeof(size_t);
-
-    return current_block_size;
-}
-
-void **allocator_sorted_list::get_first_available_block_address_address() const noexcept
-{
-    return reinterpret_cast<void **>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t) + sizeof(allocator *) + sizeof(logger *) + sizeof(allocator_fit_allocation::allocation_mode));
-}
-
-void *allocator_sorted_list::get_first_available_block_address() const noexcept
-{
-    return *get_first_available_block_address_address();
-}
-
-size_t allocator_sorted_list::get_available_block_size(
-    void const *current_block_address) const
-{
-    return *reinterpret_cast<size_t const *>(current_block_address);
-}
-
-void *allocator_sorted_list::get_available_block_next_available_block_address(
-    void const *current_block_address) const
-{
-    return *reinterpret_cast<void * const *>(reinterpret_cast<size_t const *>(current_block_address) + 1);
-}
-
-size_t allocator_sorted_list::get_occupied_block_size(
-    void const *current_block_address) const
-{
-    return *reinterpret_cast<size_t const *>(current_block_address);
-}
-
-void allocator_sorted_list::dump_trusted_memory_blocks_state() const
-{
-    if (get_logger() == nullptr)
-    {
-        return;
-    }
-
-    std::string to_dump("|");
-    auto memory_size = get_trusted_memory_size();
-    auto current_available_block = get_first_available_block_address();
-    unsigned char *first_block = reinterpret_cast<unsigned char *>(_trusted_memory) + get_allocator_service_block_size();
-    unsigned char *current_block = first_block;
-
-    while (current_block - first_block < memory_size)
-    {
-        size_t current_block_size;
-        if (current_block == current_available_block)
-        {
-            current_block_size = get_available_block_size(current_block);
-            to_dump += "avl ";
-            current_available_block = get_available_block_next_available_block_address(current_available_block);
-        }
-        else
-        {
-            current_block_size = get_occupied_block_size(current_block);
-            to_dump += "occ ";
-        }
-
-        to_dump += std::to_string(current_block_size) + "|";
-        current_block += current_block_size;
-    }
-
-    this->debug_with_guard("Memory state: " + to_dump);
-}
-
-void *allocator_sorted_list::allocate(
-    size_t requested_block_size)
-{
-    auto const got_typename = get_typename();
-    this->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution started")
-        ->debug_with_guard("Requested " + std::to_string(requested_block_size) + " bytes of memory");
-
-    auto requested_block_size_overridden = requested_block_size;
-    if (requested_block_size_overridden < sizeof(void *))
-    {
-        requested_block_size_overridden = sizeof(void *);
-    }
-
-    void *previous_block = nullptr, *current_block = get_first_available_block_address();
-    void *target_block = nullptr, *previous_to_target_block = nullptr, *next_to_target_block = nullptr;
-    auto const available_block_service_block_size = get_available_block_service_block_size();
-    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
-    auto const allocation_mode = get_allocation_mode();
-
-    while (current_block != nullptr)
-    {
-        auto const current_block_size = get_available_block_size(current_block);
-        auto const next_block = get_available_block_next_available_block_address(current_block);
-
-        if (current_block_size >= requested_block_size_overridden + occupied_block_service_block_size)
-        {
-            if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit ||
-                allocation_mode == allocator_fit_allocation::allocation_mode::the_best_fit && (target_block == nullptr || current_block_size < get_available_block_size(target_block)) ||
-                allocation_mode == allocator_fit_allocation::allocation_mode::the_worst_fit && (target_block == nullptr || current_block_size > get_available_block_size(target_block)))
-            {
-                previous_to_target_block = previous_block;
-                target_block = current_block;
-                next_to_target_block = next_block;
-            }
-
-            if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit)
-            {
-                break;
-            }
-        }
-
-        previous_block = current_block;
-        current_block = next_block;
-    }
-
-    if (target_block == nullptr)
-    {
-        auto const warning_message = "no memory available to allocate";
-
-        this->warning_with_guard(warning_message)
-            ->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution finished");
-
-        throw memory_exception(warning_message);
-    }
-
-    auto const target_block_size = get_available_block_size(target_block);
-
-    if (target_block_size - requested_block_size_overridden - occupied_block_service_block_size < available_block_service_block_size)
-    {
-        requested_block_size_overridden = target_block_size - occupied_block_service_block_size;
-    }
-
-    if (requested_block_size_overridden != requested_block_size)
-    {
-        this->trace_with_guard("Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(requested_block_size_overridden) + " bytes in according to correct work of allocator");
-
-        requested_block_size = requested_block_size_overridden;
-    }
-
-    void *updated_next_block_to_previous_block;
-
-    if (requested_block_size == target_block_size - occupied_block_service_block_size)
-    {
-        updated_next_block_to_previous_block = next_to_target_block;
-    }
-    else
-    {
-        updated_next_block_to_previous_block = reinterpret_cast<void *>(reinterpret_cast<unsigned char *>(target_block) + occupied_block_service_block_size + requested_block_size);
-
-        auto * const target_block_leftover_size = reinterpret_cast<size_t *>(updated_next_block_to_previous_block);
-        *target_block_leftover_size = target_block_size - occupied_block_service_block_size - requested_block_size;
-
-        auto * const target_block_leftover_next_block_address = reinterpret_cast<void **>(target_block_leftover_size + 1);
-        *target_block_leftover_next_block_address = next_to_target_block;
-    }
-
-    previous_to_target_block == nullptr
-        ? *get_first_available_block_address_address() = updated_next_block_to_previous_block
-        : *reinterpret_cast<void **>(reinterpret_cast<size_t *>(previous_to_target_block) + 1) = updated_next_block_to_previous_block;
-
-    auto *target_block_size_address = reinterpret_cast<size_t *>(target_block);
-    *target_block_size_address = requested_block_size + sizeof(size_t);
-
-    auto * const allocated_block = reinterpret_cast<void *>(target_block_size_address + 1);
-
-    this->trace_with_guard("Allocated block placed at " + address_to_hex(allocated_block))
-        ->trace_with_guard("Method `void *" + got_typename + "::allocate(size_t requested_block_size)` execution finished");
-
-    this->debug_with_guard("After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
-                               address_to_hex(target_block_size_address) + "):");
-    dump_trusted_memory_blocks_state();
-    return allocated_block;
-}
-
-void allocator_sorted_list::deallocate(
-    void *block_to_deallocate_address)
-{
-    auto const got_typename = get_typename();
-    this->trace_with_guard(got_typename + "::deallocate(void *block_to_deallocate_address) execution started");
-
-    // TODO: check if memory was allocated from current allocator
-    block_to_deallocate_address = reinterpret_cast<void *>(reinterpret_cast<size_t *>(block_to_deallocate_address) - 1);
-
-    dump_occupied_block_before_deallocate(block_to_deallocate_address, get_logger());
-
-    auto block_to_deallocate_size = get_occupied_block_size(block_to_deallocate_address);
-    auto *current_available_block = get_first_available_block_address();
-
-    if (current_available_block == nullptr)
-    {
-        *get_first_available_block_address_address() = block_to_deallocate_address;
-
-        auto * const block_to_deallocate_size_address = reinterpret_cast<size_t *>(block_to_deallocate_address);
-        auto * const block_to_deallocate_next_available_block_address_address = reinterpret_cast<void **>(block_to_deallocate_size_address + 1);
-        *block_to_deallocate_next_available_block_address_address = nullptr;
-    }
-    else
-    {
-        void *previous_available_block = nullptr;
-        while (current_available_block != nullptr && current_available_block < block_to_deallocate_address)
-        {
-            previous_available_block = current_available_block;
-            current_available_block = get_available_block_next_available_block_address(current_available_block);
-        }
-
-        if (current_available_block == nullptr)
-        {
-            auto const previous_available_block_size = get_available_block_size(previous_available_block);
-            if (reinterpret_cast<unsigned char *>(previous_available_block) + previous_available_block_size == block_to_deallocate_address)
-            {
-                this->trace_with_guard("Merging previous available block with target block...");
-                *reinterpret_cast<size_t *>(previous_available_block) += block_to_deallocate_size;
-                this->trace_with_guard("Merging completed");
-            }
-            else
-            {
-                *reinterpret_cast<void **>(reinterpret_cast<size_t *>(previous_available_block) + 1) = block_to_deallocate_address;
-                auto * const block_to_deallocate_size_address = reinterpret_cast<size_t *>(block_to_deallocate_address);
-                *reinterpret_cast<void **>(block_to_deallocate_size_address + 1) = nullptr;
-            }
-        }
-        else
-        {
-            if (reinterpret_cast<unsigned char *>(block_to_deallocate_address) + block_to_deallocate_size == current_available_block)
-            {
-                this->trace_with_guard("Merging next available block with target block...");
-                block_to_deallocate_size = (*reinterpret_cast<size_t *>(block_to_deallocate_address) += get_available_block_size(current_available_block));
-                *reinterpret_cast<void **>(reinterpret_cast<size_t *>(block_to_deallocate_address) + 1) = get_available_block_next_available_block_address(current_available_block);
-                this->trace_with_guard("Merging completed");
-            }
-            else
-            {
-                *reinterpret_cast<void **>(reinterpret_cast<size_t *>(block_to_deallocate_address) + 1) = current_available_block;
-            }
-
-            if (previous_available_block == nullptr)
-            {
-                *get_first_available_block_address_address() = block_to_deallocate_address;
-            }
-            else
-            {
-                auto const previous_available_block_size = get_available_block_size(previous_available_block);
-                if (reinterpret_cast<unsigned char *>(previous_available_block) + previous_available_block_size == block_to_deallocate_address)
-                {
-                    this->trace_with_guard("Merging previous available block with target block...");
-                    *reinterpret_cast<size_t *>(previous_available_block) += block_to_deallocate_size;
-                    *(reinterpret_cast<void **>(reinterpret_cast<size_t *>(previous_available_block) + 1)) = get_available_block_next_available_block_address(block_to_deallocate_address);
-                    this->trace_with_guard("Merging completed");
-                }
-                else
-                {
-                    *reinterpret_cast<void **>(reinterpret_cast<size_t *>(previous_available_block) + 1) = block_to_deallocate_address;
-                }
-            }
-        }
-    }
-
-    this->debug_with_guard("After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):");
-    dump_trusted_memory_blocks_state();
-    this->trace_with_guard(got_typename + "::deallocate method execution finished");
-}
-
-void *allocator_sorted_list::reallocate(
-    void *block_to_reallocate_address,
-    size_t new_block_size)
-{
-    auto * new_block = allocate(new_block_size);
-    auto occupied_block_service_block_size = get_occupied_block_service_block_size();
-    auto data_to_move_size = std::min(get_occupied_block_size(reinterpret_cast<unsigned char const *>(new_block) - occupied_block_service_block_size), get_occupied_block_size(reinterpret_cast<unsigned char const *>(block_to_reallocate_address) - occupied_block_service_block_size)) - occupied_block_service_block_size;
-    memcpy(new_block, block_to_reallocate_address, data_to_move_size);
-    deallocate(block_to_reallocate_address);
-    return new_block;
-}
-
-bool allocator_sorted_list::reallocate(
-    void **block_to_reallocate_address_address,
-    size_t new_block_size)
-{
-    try {
-        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
-        return true;
-    }
-    catch (std::exception const &ex)
-    {
-        this->warning_with_guard(ex.what());
-        return false;
-    }
-}
-
-void allocator_sorted_list::setup_allocation_mode(
-        allocator_fit_allocation::allocation_mode mode)
-{
-    *reinterpret_cast<allocator_fit_allocation::allocation_mode *>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t) + sizeof(allocator *) + sizeof(logger *)) = mode;
-}
-
-logger *allocator_sorted_list::get_logger() const noexcept
-{
-    return *reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1);
-}
-
-std::string allocator_sorted_list::get_typename() const noexcept
-{
-    return "allocator_sorted_list";
-}
-
-allocator *allocator_sorted_list::get_allocator() const noexcept
-{
-    return *reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1);
-}
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include "bit_operations.h"
+#include "allocator_sorted_list.h"
+
+allocator_sorted_list::allocator_sorted_list(
+    size_t memory_size,
+    allocator *outer_allocator,
+    logger *log,
+    allocator_fit_allocation::allocation_mode allocation_mode)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested memory size: " + std::to_string(memory_size) + " bytes");
+    }
+
+    // block sizes are kept multiple of block alignment, so the lowest bits of block size hold block flags
+    memory_size = memory_size / block_alignment * block_alignment;
+
+    auto const minimal_trusted_memory_size = get_available_block_service_block_size();
+
+    if (memory_size < minimal_trusted_memory_size)
+    {
+        auto error_message = "trusted memory size should be GT " + std::to_string(minimal_trusted_memory_size) + " bytes";
+
+        if (log != nullptr)
+        {
+            log->error(error_message);
+        }
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    auto const allocator_service_block_size = get_allocator_service_block_size();
+    auto const fence_block_size = get_occupied_block_service_block_size();
+
+    _trusted_memory = outer_allocator == nullptr
+        ? ::operator new(memory_size + allocator_service_block_size + fence_block_size, std::align_val_t(cache_line_size))
+        : outer_allocator->allocate_aligned(memory_size + allocator_service_block_size + fence_block_size, cache_line_size);
+
+    auto * const header = new (_trusted_memory) trusted_memory_header();
+    header->allocation_mode = allocation_mode;
+    header->logger = log;
+    header->memory_size = memory_size;
+    header->outer_allocator = outer_allocator;
+
+    initialize_growth_service_block(get_growth_service_block_address());
+
+    auto * const bins_occupancy_bitmap = get_bins_occupancy_bitmap_address();
+    for (size_t i = 0; i < bins_occupancy_bitmap_words_count; i++)
+    {
+        bins_occupancy_bitmap[i] = 0;
+    }
+
+    auto * const bins = get_bins_address();
+    for (size_t i = 0; i < bins_count; i++)
+    {
+        bins[i] = nullptr;
+    }
+
+    auto * const first_block = reinterpret_cast<unsigned char *>(_trusted_memory) + allocator_service_block_size;
+
+    // occupied block of zero size stops physical neighbours lookup at the end of trusted memory
+    *reinterpret_cast<size_t *>(first_block + memory_size) = block_occupancy_flag;
+
+    insert_available_block(first_block, memory_size);
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_sorted_list::~allocator_sorted_list() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    release_chunks();
+
+    deallocate_aligned_with_guard(_trusted_memory, cache_line_size);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_sorted_list::get_trusted_memory_size() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->memory_size;
+}
+
+allocator_fit_allocation::allocation_mode allocator_sorted_list::get_allocation_mode() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->allocation_mode;
+}
+
+size_t allocator_sorted_list::get_allocator_service_block_size() const noexcept
+{
+    return first_block_offset;
+}
+
+size_t allocator_sorted_list::get_available_block_service_block_size() const noexcept
+{
+    auto const current_block_size = sizeof(size_t);
+    auto const previous_available_block_pointer_size = sizeof(void *);
+    auto const next_available_block_pointer_size = sizeof(void *);
+    auto const current_block_size_footer_size = sizeof(size_t);
+
+    return current_block_size + previous_available_block_pointer_size + next_available_block_pointer_size + current_block_size_footer_size;
+}
+
+size_t allocator_sorted_list::get_occupied_block_service_block_size() const noexcept
+{
+    auto const current_block_size = sizeof(size_t);
+
+    return current_block_size;
+}
+
+bool allocator_sorted_list::get_block_occupancy(
+    void const *block_pointer) const
+{
+    return (*reinterpret_cast<size_t const *>(block_pointer) & block_occupancy_flag) != 0;
+}
+
+size_t allocator_sorted_list::get_available_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address) & ~block_flags_mask;
+}
+
+void *allocator_sorted_list::get_available_block_previous_available_block_address(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<void * const *>(reinterpret_cast<size_t const *>(current_block_address) + 1);
+}
+
+void *allocator_sorted_list::get_available_block_next_available_block_address(
+    void const *current_block_address) const
+{
+    return *(reinterpret_cast<void * const *>(reinterpret_cast<size_t const *>(current_block_address) + 1) + 1);
+}
+
+size_t allocator_sorted_list::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address) & ~block_flags_mask;
+}
+
+void allocator_sorted_list::dump_trusted_memory_blocks_state() const
+{
+    if (!is_enabled_with_guard(logger::severity::debug))
+    {
+        return;
+    }
+
+    std::string to_dump("|");
+    auto *current_block = reinterpret_cast<unsigned char *>(_trusted_memory) + get_allocator_service_block_size();
+
+    while (true)
+    {
+        size_t current_block_size;
+        if (get_block_occupancy(current_block))
+        {
+            current_block_size = get_occupied_block_size(current_block);
+            if (current_block_size == 0)
+            {
+                break;
+            }
+
+            to_dump += "occ ";
+        }
+        else
+        {
+            current_block_size = get_available_block_size(current_block);
+            to_dump += "avl ";
+        }
+
+        to_dump += std::to_string(current_block_size) + "|";
+        current_block += current_block_size;
+    }
+
+    this->debug_with_guard([&] { return "Memory state: " + to_dump; });
+}
+
+size_t *allocator_sorted_list::get_bins_occupancy_bitmap_address() const noexcept
+{
+    return reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(_trusted_memory) + bins_occupancy_bitmap_offset);
+}
+
+void **allocator_sorted_list::get_bins_address() const noexcept
+{
+    return reinterpret_cast<void **>(get_bins_occupancy_bitmap_address() + bins_occupancy_bitmap_words_count);
+}
+
+size_t allocator_sorted_list::get_bin_index(
+    size_t block_size) noexcept
+{
+    auto const power = bit_operations::find_last_set(block_size);
+
+    if (power < bin_subdivision_bits_count)
+    {
+        return power << bin_subdivision_bits_count;
+    }
+
+    // bits following the highest set one pick the bin inside of the power of two range
+    auto const subdivision_index = (block_size >> (power - bin_subdivision_bits_count)) & ((static_cast<size_t>(1) << bin_subdivision_bits_count) - 1);
+
+    return (power << bin_subdivision_bits_count) | subdivision_index;
+}
+
+size_t allocator_sorted_list::find_first_occupied_bin_index(
+    size_t bin_index) const noexcept
+{
+    auto const * const bins_occupancy_bitmap = get_bins_occupancy_bitmap_address();
+
+    for (auto word_index = bin_index / bins_occupancy_bitmap_word_bits_count; word_index < bins_occupancy_bitmap_words_count; word_index++)
+    {
+        auto word = bins_occupancy_bitmap[word_index];
+
+        if (word_index == bin_index / bins_occupancy_bitmap_word_bits_count)
+        {
+            word &= ~static_cast<size_t>(0) << (bin_index % bins_occupancy_bitmap_word_bits_count);
+        }
+
+        if (word != 0)
+        {
+            return word_index * bins_occupancy_bitmap_word_bits_count + bit_operations::find_first_set(word);
+        }
+    }
+
+    return bins_count;
+}
+
+size_t allocator_sorted_list::find_last_occupied_bin_index() const noexcept
+{
+    auto const * const bins_occupancy_bitmap = get_bins_occupancy_bitmap_address();
+
+    for (auto word_index = bins_occupancy_bitmap_words_count; word_index-- > 0;)
+    {
+        if (bins_occupancy_bitmap[word_index] != 0)
+        {
+            return word_index * bins_occupancy_bitmap_word_bits_count + bit_operations::find_last_set(bins_occupancy_bitmap[word_index]);
+        }
+    }
+
+    return bins_count;
+}
+
+void *allocator_sorted_list::find_available_block(
+    size_t block_size) const
+{
+    auto * const bins = get_bins_address();
+    auto const allocation_mode = get_allocation_mode();
+
+    void *target_block = nullptr;
+
+    if (allocation_mode == allocator_fit_allocation::allocation_mode::the_worst_fit)
+    {
+        auto const last_occupied_bin_index = find_last_occupied_bin_index();
+
+        if (last_occupied_bin_index == bins_count)
+        {
+            return nullptr;
+        }
+
+        // the largest block lives in the highest non-empty bin
+        for (auto *current_block = bins[last_occupied_bin_index]; current_block != nullptr; current_block = get_available_block_next_available_block_address(current_block))
+        {
+            if (target_block == nullptr || get_available_block_size(current_block) > get_available_block_size(target_block))
+            {
+                target_block = current_block;
+            }
+        }
+
+        return get_available_block_size(target_block) >= block_size
+            ? target_block
+            : nullptr;
+    }
+
+    // only the bin of requested size may contain blocks which are too small
+    auto const bin_index = get_bin_index(block_size);
+
+    if (allocation_mode == allocator_fit_allocation::allocation_mode::next_fit)
+    {
+        target_block = find_next_fit_available_block(bin_index, block_size);
+    }
+    else
+    {
+        for (auto *current_block = bins[bin_index]; current_block != nullptr; current_block = get_available_block_next_available_block_address(current_block))
+        {
+            auto const current_block_size = get_available_block_size(current_block);
+
+            if (current_block_size >= block_size && (target_block == nullptr || current_block_size < get_available_block_size(target_block)))
+            {
+                target_block = current_block;
+
+                if (allocation_mode == allocator_fit_allocation::allocation_mode::first_fit || current_block_size == block_size)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (target_block != nullptr)
+    {
+        return target_block;
+    }
+
+    auto const greater_bin_index = find_first_occupied_bin_index(bin_index + 1);
+
+    if (greater_bin_index == bins_count)
+    {
+        return nullptr;
+    }
+
+    // every block of greater bins fits, so first fit takes the head of the first of them
+    target_block = bins[greater_bin_index];
+
+    if (allocation_mode == allocator_fit_allocation::allocation_mode::the_best_fit)
+    {
+        for (auto *current_block = get_available_block_next_available_block_address(target_block); current_block != nullptr; current_block = get_available_block_next_available_block_address(current_block))
+        {
+            if (get_available_block_size(current_block) < get_available_block_size(target_block))
+            {
+                target_block = current_block;
+            }
+        }
+    }
+    else if (allocation_mode == allocator_fit_allocation::allocation_mode::next_fit)
+    {
+        target_block = find_next_fit_available_block(greater_bin_index, 0);
+    }
+
+    return target_block;
+}
+
+void *allocator_sorted_list::find_next_fit_available_block(
+    size_t bin_index,
+    size_t block_size) const
+{
+    auto * const first_bin_block = get_bins_address()[bin_index];
+    auto * const rover = *get_next_fit_rover_address_address();
+
+    auto * const first_block_to_scan = rover != nullptr && get_bin_index(get_available_block_size(rover)) == bin_index
+        ? rover
+        : first_bin_block;
+
+    for (auto *current_block = first_block_to_scan; current_block != nullptr; current_block = get_available_block_next_available_block_address(current_block))
+    {
+        if (get_available_block_size(current_block) >= block_size)
+        {
+            return current_block;
+        }
+    }
+
+    if (first_block_to_scan == first_bin_block)
+    {
+        return nullptr;
+    }
+
+    for (auto *current_block = first_bin_block; current_block != first_block_to_scan; current_block = get_available_block_next_available_block_address(current_block))
+    {
+        if (get_available_block_size(current_block) >= block_size)
+        {
+            return current_block;
+        }
+    }
+
+    return nullptr;
+}
+
+void allocator_sorted_list::insert_available_block(
+    void *block_address,
+    size_t block_size)
+{
+    auto * const block_size_address = reinterpret_cast<size_t *>(block_address);
+    *block_size_address = block_size;
+    *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(block_address) + block_size - sizeof(size_t)) = block_size;
+    *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(block_address) + block_size) |= previous_block_availability_flag;
+
+    auto const bin_index = get_bin_index(block_size);
+    auto * const bin_address = get_bins_address() + bin_index;
+
+    // block is pushed to the head of its bin, so insertion takes constant time
+    auto * const next_available_block = *bin_address;
+
+    auto * const previous_available_block_address_address = reinterpret_cast<void **>(block_size_address + 1);
+    *previous_available_block_address_address = nullptr;
+    *(previous_available_block_address_address + 1) = next_available_block;
+
+    *bin_address = block_address;
+
+    if (next_available_block != nullptr)
+    {
+        *reinterpret_cast<void **>(reinterpret_cast<size_t *>(next_available_block) + 1) = block_address;
+    }
+
+    get_bins_occupancy_bitmap_address()[bin_index / bins_occupancy_bitmap_word_bits_count] |= static_cast<size_t>(1) << (bin_index % bins_occupancy_bitmap_word_bits_count);
+}
+
+void allocator_sorted_list::remove_available_block(
+    void *block_address)
+{
+    auto const bin_index = get_bin_index(get_available_block_size(block_address));
+    auto * const previous_available_block = get_available_block_previous_available_block_address(block_address);
+    auto * const next_available_block = get_available_block_next_available_block_address(block_address);
+
+    if (previous_available_block == nullptr)
+    {
+        get_bins_address()[bin_index] = next_available_block;
+
+        if (next_available_block == nullptr)
+        {
+            get_bins_occupancy_bitmap_address()[bin_index / bins_occupancy_bitmap_word_bits_count] &= ~(static_cast<size_t>(1) << (bin_index % bins_occupancy_bitmap_word_bits_count));
+        }
+    }
+    else
+    {
+        *(reinterpret_cast<void **>(reinterpret_cast<size_t *>(previous_available_block) + 1) + 1) = next_available_block;
+    }
+
+    if (next_available_block != nullptr)
+    {
+        *reinterpret_cast<void **>(reinterpret_cast<size_t *>(next_available_block) + 1) = previous_available_block;
+    }
+
+    // rover always refers to a listed block, so it moves on when its block is taken or merged
+    auto * const next_fit_rover_address_address = get_next_fit_rover_address_address();
+    if (*next_fit_rover_address_address == block_address)
+    {
+        *next_fit_rover_address_address = next_available_block;
+    }
+}
+
+void allocator_sorted_list::set_occupied_block_size(
+    void *block_address,
+    size_t block_size)
+{
+    auto * const block_size_address = reinterpret_cast<size_t *>(block_address);
+    *block_size_address = block_size | block_occupancy_flag | (*block_size_address & previous_block_availability_flag);
+    *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(block_address) + block_size) &= ~previous_block_availability_flag;
+}
+
+size_t allocator_sorted_list::get_previous_available_block_size(
+    void const *block_address) const
+{
+    auto const * const block_size_address = reinterpret_cast<size_t const *>(block_address);
+
+    // footer of the previous block is only kept while that block is available
+    return (*block_size_address & previous_block_availability_flag) != 0
+        ? *(block_size_address - 1)
+        : 0;
+}
+
+void *allocator_sorted_list::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!is_block_size_supported(requested_block_size, alignment))
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    auto const available_block_service_block_size = get_available_block_service_block_size();
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+
+    auto requested_block_size_overridden = get_aligned_block_size(requested_block_size + occupied_block_service_block_size) - occupied_block_service_block_size;
+    if (requested_block_size_overridden + occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = available_block_service_block_size - occupied_block_service_block_size;
+    }
+
+    // space skipped to align the block is left available, so it should fit an available block
+    auto const alignment_padding_size = alignment > block_alignment
+        ? alignment + available_block_service_block_size
+        : 0;
+
+    auto *target_block = find_available_block(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size);
+
+    if (target_block == nullptr)
+    {
+        target_block = grow(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size, lock);
+    }
+
+    if (target_block == nullptr)
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    auto target_block_size = get_available_block_size(target_block);
+    remove_available_block(target_block);
+
+    auto const aligned_block_offset = get_aligned_block_offset(target_block, sizeof(size_t), alignment, available_block_service_block_size);
+
+    if (aligned_block_offset != 0)
+    {
+        insert_available_block(target_block, aligned_block_offset);
+        target_block = reinterpret_cast<unsigned char *>(target_block) + aligned_block_offset;
+        target_block_size -= aligned_block_offset;
+    }
+
+    if (target_block_size - requested_block_size_overridden - occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = target_block_size - occupied_block_service_block_size;
+
+        *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(target_block) + target_block_size) &= ~previous_block_availability_flag;
+    }
+    else
+    {
+        auto * const rest_block = reinterpret_cast<unsigned char *>(target_block) + occupied_block_service_block_size + requested_block_size_overridden;
+        insert_available_block(rest_block, target_block_size - occupied_block_service_block_size - requested_block_size_overridden);
+
+        // next fit resumes from the rest of the block just split
+        *get_next_fit_rover_address_address() = rest_block;
+    }
+
+    if (requested_block_size_overridden != requested_block_size)
+    {
+        this->trace_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(requested_block_size_overridden) + " bytes in according to correct work of allocator"; });
+
+        requested_block_size = requested_block_size_overridden;
+    }
+
+    auto *target_block_size_address = reinterpret_cast<size_t *>(target_block);
+    // block placed after the space skipped for alignment keeps the previous block availability flag it has got
+    *target_block_size_address = (requested_block_size + occupied_block_service_block_size) | block_occupancy_flag | (*target_block_size_address & previous_block_availability_flag);
+
+    auto * const allocated_block = reinterpret_cast<void *>(target_block_size_address + 1);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); });
+
+    this->debug_with_guard([&] { return "After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
+                               address_to_hex(target_block_size_address) + "):"; });
+    dump_trusted_memory_blocks_state();
+    return allocated_block;
+}
+
+void *allocator_sorted_list::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto * const allocated_block = allocate_block(requested_block_size, block_alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+void *allocator_sorted_list::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
+    {
+        auto const warning_message = "alignment should be a power of 2";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate_block(requested_block_size, alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+void *allocator_sorted_list::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    try
+    {
+        return allocate_block(requested_block_size, block_alignment);
+    }
+    catch (...)
+    {
+        // outer allocator may throw while heap grows
+        return nullptr;
+    }
+}
+
+void allocator_sorted_list::allocate_batch(
+    size_t requested_block_size,
+    size_t blocks_count,
+    void **allocated_blocks_addresses)
+{
+    allocate_batch_blocks(*get_lock(), requested_block_size, blocks_count, allocated_blocks_addresses);
+}
+
+void allocator_sorted_list::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    // TODO: check if memory was allocated from current allocator
+    block_to_deallocate_address = reinterpret_cast<void *>(reinterpret_cast<size_t *>(block_to_deallocate_address) - 1);
+
+    dump_occupied_block_before_deallocate(block_to_deallocate_address, get_logger());
+
+    auto block_to_deallocate_size = get_occupied_block_size(block_to_deallocate_address);
+    auto * const next_block = reinterpret_cast<unsigned char *>(block_to_deallocate_address) + block_to_deallocate_size;
+
+    if ((*reinterpret_cast<size_t *>(block_to_deallocate_address) & previous_block_availability_flag) != 0)
+    {
+        this->trace_with_guard("Merging previous available block with target block...");
+        auto const previous_available_block_size = *(reinterpret_cast<size_t *>(block_to_deallocate_address) - 1);
+        block_to_deallocate_address = reinterpret_cast<unsigned char *>(block_to_deallocate_address) - previous_available_block_size;
+        remove_available_block(block_to_deallocate_address);
+        block_to_deallocate_size += previous_available_block_size;
+        this->trace_with_guard("Merging completed");
+    }
+
+    if (!get_block_occupancy(next_block))
+    {
+        this->trace_with_guard("Merging next available block with target block...");
+        block_to_deallocate_size += get_available_block_size(next_block);
+        remove_available_block(next_block);
+        this->trace_with_guard("Merging completed");
+    }
+
+    auto * const released_chunk = unlink_released_chunk(get_growth_service_block_address(), block_to_deallocate_address, block_to_deallocate_size);
+
+    if (released_chunk == nullptr)
+    {
+        insert_available_block(block_to_deallocate_address, block_to_deallocate_size);
+    }
+
+    this->debug_with_guard([&] { return "After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):"; });
+    dump_trusted_memory_blocks_state();
+    lock.unlock();
+
+    if (released_chunk != nullptr)
+    {
+        release_chunk(released_chunk);
+    }
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void allocator_sorted_list::deallocate_batch(
+    void **blocks_to_deallocate_addresses,
+    size_t blocks_count)
+{
+    deallocate_batch_blocks(*get_lock(), blocks_to_deallocate_addresses, blocks_count);
+}
+
+void *allocator_sorted_list::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(new_block_size) + " bytes of memory for block placed at " + address_to_hex(block_to_reallocate_address); });
+
+    auto * const reallocated_block = reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+    if (reallocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return reallocated_block;
+}
+
+bool allocator_sorted_list::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    auto * const reallocated_block = try_reallocate(*block_to_reallocate_address_address, new_block_size);
+
+    if (reallocated_block == nullptr)
+    {
+        return false;
+    }
+
+    *block_to_reallocate_address_address = reallocated_block;
+    return true;
+}
+
+void *allocator_sorted_list::try_reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    try
+    {
+        return reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+    }
+    catch (...)
+    {
+        // outer allocator may throw while heap grows
+        return nullptr;
+    }
+}
+
+void allocator_sorted_list::setup_allocation_mode(
+        allocator_fit_allocation::allocation_mode mode)
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    reinterpret_cast<trusted_memory_header *>(_trusted_memory)->allocation_mode = mode;
+}
+
+void allocator_sorted_list::setup_growth(
+    size_t chunk_size,
+    size_t free_chunks_high_water_mark)
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    setup_growth_service_block(get_growth_service_block_address(), std::max(chunk_size, get_available_block_service_block_size()), free_chunks_high_water_mark);
+}
+
+spinlock *allocator_sorted_list::get_lock() const noexcept
+{
+    return &reinterpret_cast<trusted_memory_header *>(_trusted_memory)->lock;
+}
+
+void **allocator_sorted_list::get_next_fit_rover_address_address() const noexcept
+{
+    return &reinterpret_cast<trusted_memory_header *>(_trusted_memory)->next_fit_rover;
+}
+
+void *allocator_sorted_list::get_growth_service_block_address() const noexcept
+{
+    return reinterpret_cast<unsigned char *>(_trusted_memory) + growth_service_block_offset;
+}
+
+logger *allocator_sorted_list::get_logger() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->logger;
+}
+
+std::string allocator_sorted_list::get_typename() const noexcept
+{
+    return "allocator_sorted_list";
+}
+
+allocator *allocator_sorted_list::get_allocator() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->outer_allocator;
+}
@@ -0,0 +1,345 @@
+#include <mutex>
+#include "allocator_stack.h"
+
+allocator_stack::allocator_stack(
+    size_t memory_size,
+    allocator *outer_allocator,
+    logger *log)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested memory size: " + std::to_string(memory_size) + " bytes");
+    }
+
+    memory_size = (memory_size + block_alignment - 1) / block_alignment * block_alignment;
+
+    auto const allocator_service_block_size = get_allocator_service_block_size();
+
+    _trusted_memory = outer_allocator == nullptr
+        ? ::operator new(allocator_service_block_size + memory_size)
+        : outer_allocator->allocate(allocator_service_block_size + memory_size);
+
+    auto * const memory_size_space = reinterpret_cast<size_t *>(_trusted_memory);
+    *memory_size_space = memory_size;
+
+    auto * const outer_allocator_pointer_space = reinterpret_cast<allocator **>(memory_size_space + 1);
+    *outer_allocator_pointer_space = outer_allocator;
+
+    auto * const logger_pointer_space = reinterpret_cast<logger **>(outer_allocator_pointer_space + 1);
+    *logger_pointer_space = log;
+
+    new (get_lock()) spinlock();
+
+    *get_top_address_address() = reinterpret_cast<unsigned char *>(_trusted_memory) + allocator_service_block_size;
+    *get_last_block_address_address() = nullptr;
+    *get_current_frame_address_address() = nullptr;
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_stack::~allocator_stack() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    deallocate_with_guard(_trusted_memory);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_stack::get_trusted_memory_size() const noexcept
+{
+    return *reinterpret_cast<size_t *>(_trusted_memory);
+}
+
+size_t allocator_stack::get_allocator_service_block_size() const noexcept
+{
+    auto const memory_size_size = sizeof(size_t);
+    auto const outer_allocator_pointer_size = sizeof(allocator *);
+    auto const logger_pointer_size = sizeof(logger *);
+    auto const lock_size = sizeof(spinlock);
+    auto const top_pointer_size = sizeof(unsigned char *);
+    auto const last_block_pointer_size = sizeof(void *);
+    auto const current_frame_pointer_size = sizeof(void *);
+
+    return memory_size_size + outer_allocator_pointer_size + logger_pointer_size + lock_size + top_pointer_size + last_block_pointer_size + current_frame_pointer_size;
+}
+
+size_t allocator_stack::get_occupied_block_service_block_size() const noexcept
+{
+    auto const previous_block_pointer_size = sizeof(void *);
+
+    return previous_block_pointer_size;
+}
+
+void *allocator_stack::get_occupied_block_previous_occupied_block_address(
+    void const *current_block_address) const
+{
+    return reinterpret_cast<void *>(*reinterpret_cast<std::uintptr_t const *>(current_block_address) & ~padded_block_flag);
+}
+
+spinlock *allocator_stack::get_lock() const noexcept
+{
+    return reinterpret_cast<spinlock *>(reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1) + 1);
+}
+
+unsigned char **allocator_stack::get_top_address_address() const noexcept
+{
+    return reinterpret_cast<unsigned char **>(get_lock() + 1);
+}
+
+void **allocator_stack::get_last_block_address_address() const noexcept
+{
+    return reinterpret_cast<void **>(get_top_address_address() + 1);
+}
+
+void **allocator_stack::get_current_frame_address_address() const noexcept
+{
+    return get_last_block_address_address() + 1;
+}
+
+unsigned char *allocator_stack::get_end_address() const noexcept
+{
+    return reinterpret_cast<unsigned char *>(_trusted_memory) + get_allocator_service_block_size() + get_trusted_memory_size();
+}
+
+void *allocator_stack::push_block(
+    size_t block_data_size,
+    size_t alignment)
+{
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+    auto * const top_address_address = get_top_address_address();
+    // padding before aligned block keeps its own size in the last word, so popping the block pops the padding too
+    auto const aligned_block_offset = get_aligned_block_offset(*top_address_address, occupied_block_service_block_size, alignment, sizeof(size_t));
+
+    if (static_cast<size_t>(get_end_address() - *top_address_address) < aligned_block_offset + occupied_block_service_block_size + block_data_size)
+    {
+        auto const warning_message = "no memory available to allocate";
+
+        this->warning_with_guard(warning_message);
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const last_block_address_address = get_last_block_address_address();
+    auto * const block = *top_address_address + aligned_block_offset;
+
+    *reinterpret_cast<void **>(block) = *last_block_address_address;
+
+    if (aligned_block_offset != 0)
+    {
+        *(reinterpret_cast<size_t *>(block) - 1) = aligned_block_offset;
+        *reinterpret_cast<std::uintptr_t *>(block) |= padded_block_flag;
+    }
+
+    *last_block_address_address = block;
+    *top_address_address = block + occupied_block_service_block_size + block_data_size;
+
+    return block;
+}
+
+void allocator_stack::handle_out_of_order_deallocation(
+    std::string const &message) const
+{
+#ifndef NDEBUG
+    this->error_with_guard(message);
+
+    throw memory_exception(message);
+#else
+    // block stays occupied until the enclosing frame is popped
+    this->warning_with_guard(message);
+#endif
+}
+
+void *allocator_stack::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto const block_data_size = (requested_block_size + block_alignment - 1) / block_alignment * block_alignment;
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const allocated_block = push_block(block_data_size);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); })
+        ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    return reinterpret_cast<void **>(allocated_block) + 1;
+}
+
+void allocator_stack::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    auto * const block_address = reinterpret_cast<void **>(block_to_deallocate_address) - 1;
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const last_block_address_address = get_last_block_address_address();
+
+    if (block_address != *last_block_address_address)
+    {
+        handle_out_of_order_deallocation("block at " + address_to_hex(block_address) + " is not on top of the stack");
+
+        this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+
+        return;
+    }
+
+    *last_block_address_address = get_occupied_block_previous_occupied_block_address(block_address);
+    *get_top_address_address() = reinterpret_cast<unsigned char *>(block_address) - ((*reinterpret_cast<std::uintptr_t *>(block_address) & padded_block_flag) == 0
+        ? 0
+        : *(reinterpret_cast<size_t *>(block_address) - 1));
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void *allocator_stack::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution started"; });
+
+    auto * const block_address = reinterpret_cast<void **>(block_to_reallocate_address) - 1;
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    if (block_address != *get_last_block_address_address())
+    {
+        auto const warning_message = "only the block on top of the stack can be reallocated";
+
+        this->warning_with_guard(warning_message);
+
+        throw memory_exception(warning_message);
+    }
+
+    // nothing can be placed above the topmost block, so it's resized in place or not at all
+    auto const new_block_data_size = (new_block_size + block_alignment - 1) / block_alignment * block_alignment;
+    auto * const block_data_address = reinterpret_cast<unsigned char *>(block_to_reallocate_address);
+
+    if (static_cast<size_t>(get_end_address() - block_data_address) < new_block_data_size)
+    {
+        auto const warning_message = "no memory available to allocate";
+
+        this->warning_with_guard(warning_message);
+
+        throw memory_exception(warning_message);
+    }
+
+    *get_top_address_address() = block_data_address + new_block_data_size;
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+    return block_to_reallocate_address;
+}
+
+void *allocator_stack::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
+    {
+        auto const warning_message = "alignment should be a power of 2";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto const block_data_size = (requested_block_size + block_alignment - 1) / block_alignment * block_alignment;
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const allocated_block = push_block(block_data_size, alignment);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); })
+        ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    return reinterpret_cast<void **>(allocated_block) + 1;
+}
+
+bool allocator_stack::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    try {
+        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
+        return true;
+    }
+    catch (std::exception const &ex)
+    {
+        this->warning_with_guard(ex.what());
+        return false;
+    }
+}
+
+void allocator_stack::push_frame()
+{
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::push_frame()` execution started"; });
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    // frame marker is an ordinary block keeping the previous frame address
+    auto * const frame = push_block(sizeof(void *));
+    auto * const current_frame_address_address = get_current_frame_address_address();
+
+    *(reinterpret_cast<void **>(frame) + 1) = *current_frame_address_address;
+    *current_frame_address_address = frame;
+
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::push_frame()` execution finished"; });
+}
+
+void allocator_stack::pop_frame()
+{
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::pop_frame()` execution started"; });
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto * const current_frame_address_address = get_current_frame_address_address();
+    auto * const frame = *current_frame_address_address;
+
+    if (frame == nullptr)
+    {
+        auto const warning_message = "no frame to pop";
+
+        this->warning_with_guard(warning_message);
+
+        throw memory_exception(warning_message);
+    }
+
+    *current_frame_address_address = *(reinterpret_cast<void **>(frame) + 1);
+    *get_last_block_address_address() = get_occupied_block_previous_occupied_block_address(frame);
+    *get_top_address_address() = reinterpret_cast<unsigned char *>(frame);
+
+    this->trace_with_guard([&] { return "Method `void " + get_typename() + "::pop_frame()` execution finished"; });
+}
+
+logger *allocator_stack::get_logger() const noexcept
+{
+    return *reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1);
+}
+
+std::string allocator_stack::get_typename() const noexcept
+{
+    return "allocator_stack";
+}
+
+allocator *allocator_stack::get_allocator() const noexcept
+{
+    return *reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1);
+}
@@ -0,0 +1,114 @@
+#ifndef DATA_STRUCTURES_CPP_MEMORY_WITH_STACK_H
+#define DATA_STRUCTURES_CPP_MEMORY_WITH_STACK_H
+
+#include <cstdint>
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "allocator_holder.h"
+#include "spinlock.h"
+
+class allocator_stack final:
+    public allocator,
+    protected logger_holder,
+    protected typename_holder,
+    protected allocator_holder
+{
+
+private:
+
+    void *_trusted_memory;
+
+private:
+
+    static constexpr size_t block_alignment = sizeof(size_t);
+
+    static constexpr std::uintptr_t padded_block_flag = 1;
+
+public:
+
+    explicit allocator_stack(
+        size_t memory_size,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr);
+
+    allocator_stack(
+        allocator_stack const &other) = delete;
+
+    allocator_stack &operator=(
+        allocator_stack const &other) = delete;
+
+    ~allocator_stack() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_trusted_memory_size() const noexcept override;
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    void *get_occupied_block_previous_occupied_block_address(
+        void const *current_block_address) const override;
+
+private:
+
+    [[nodiscard]] spinlock *get_lock() const noexcept;
+
+    [[nodiscard]] unsigned char **get_top_address_address() const noexcept;
+
+    [[nodiscard]] void **get_last_block_address_address() const noexcept;
+
+    [[nodiscard]] void **get_current_frame_address_address() const noexcept;
+
+    [[nodiscard]] unsigned char *get_end_address() const noexcept;
+
+    void *push_block(
+        size_t block_data_size,
+        size_t alignment = block_alignment);
+
+    void handle_out_of_order_deallocation(
+        std::string const &message) const;
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+public:
+
+    void push_frame();
+
+    void pop_frame();
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+private:
+
+    [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_MEMORY_WITH_STACK_H
@@ -0,0 +1,688 @@
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include "bit_operations.h"
+#include "allocator_tlsf.h"
+
+allocator_tlsf::allocator_tlsf(
+    size_t memory_size,
+    allocator *outer_allocator,
+    logger *log,
+    allocator_fit_allocation::allocation_mode allocation_mode)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested memory size: " + std::to_string(memory_size) + " bytes");
+    }
+
+    // blocks are picked by size class through bitmaps, the lists themselves are never walked in address order
+    throw_if_next_fit_requested(allocation_mode, log);
+
+    // block sizes are kept multiple of block alignment, so the lowest bits of block size hold block flags
+    memory_size = memory_size / block_alignment * block_alignment;
+
+    auto const minimal_trusted_memory_size = get_available_block_service_block_size();
+
+    if (memory_size < minimal_trusted_memory_size)
+    {
+        auto error_message = "trusted memory size should be GT " + std::to_string(minimal_trusted_memory_size) + " bytes";
+
+        if (log != nullptr)
+        {
+            log->error(error_message);
+        }
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    auto const allocator_service_block_size = get_allocator_service_block_size();
+    auto const fence_block_size = get_occupied_block_service_block_size();
+
+    _trusted_memory = outer_allocator == nullptr
+        ? ::operator new(memory_size + allocator_service_block_size + fence_block_size, std::align_val_t(cache_line_size))
+        : outer_allocator->allocate_aligned(memory_size + allocator_service_block_size + fence_block_size, cache_line_size);
+
+    auto * const header = new (_trusted_memory) trusted_memory_header();
+    header->allocation_mode = allocation_mode;
+    header->logger = log;
+    header->memory_size = memory_size;
+    header->outer_allocator = outer_allocator;
+
+    initialize_growth_service_block(get_growth_service_block_address());
+
+    *get_first_level_bitmap_address() = 0;
+
+    auto * const second_level_bitmaps = get_second_level_bitmaps_address();
+    for (size_t i = 0; i < first_level_index_count; i++)
+    {
+        second_level_bitmaps[i] = 0;
+    }
+
+    auto * const free_lists = get_free_lists_address();
+    for (size_t i = 0; i < first_level_index_count * second_level_index_count; i++)
+    {
+        free_lists[i] = nullptr;
+    }
+
+    auto * const first_block = reinterpret_cast<unsigned char *>(_trusted_memory) + allocator_service_block_size;
+
+    // occupied block of zero size stops physical neighbours lookup at the end of trusted memory
+    *reinterpret_cast<size_t *>(first_block + memory_size) = block_occupancy_flag;
+
+    insert_available_block(first_block, memory_size);
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_tlsf::~allocator_tlsf() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    release_chunks();
+
+    deallocate_aligned_with_guard(_trusted_memory, cache_line_size);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_tlsf::get_trusted_memory_size() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->memory_size;
+}
+
+allocator_fit_allocation::allocation_mode allocator_tlsf::get_allocation_mode() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->allocation_mode;
+}
+
+size_t allocator_tlsf::get_allocator_service_block_size() const noexcept
+{
+    return first_block_offset;
+}
+
+size_t allocator_tlsf::get_available_block_service_block_size() const noexcept
+{
+    auto const current_block_size = sizeof(size_t);
+    auto const previous_available_block_pointer_size = sizeof(void *);
+    auto const next_available_block_pointer_size = sizeof(void *);
+    auto const current_block_size_footer_size = sizeof(size_t);
+
+    return current_block_size + previous_available_block_pointer_size + next_available_block_pointer_size + current_block_size_footer_size;
+}
+
+size_t allocator_tlsf::get_occupied_block_service_block_size() const noexcept
+{
+    auto const current_block_size = sizeof(size_t);
+
+    return current_block_size;
+}
+
+bool allocator_tlsf::get_block_occupancy(
+    void const *block_pointer) const
+{
+    return (*reinterpret_cast<size_t const *>(block_pointer) & block_occupancy_flag) != 0;
+}
+
+size_t allocator_tlsf::get_available_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address) & ~block_flags_mask;
+}
+
+void *allocator_tlsf::get_available_block_previous_available_block_address(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<void * const *>(reinterpret_cast<size_t const *>(current_block_address) + 1);
+}
+
+void *allocator_tlsf::get_available_block_next_available_block_address(
+    void const *current_block_address) const
+{
+    return *(reinterpret_cast<void * const *>(reinterpret_cast<size_t const *>(current_block_address) + 1) + 1);
+}
+
+size_t allocator_tlsf::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address) & ~block_flags_mask;
+}
+
+void allocator_tlsf::dump_trusted_memory_blocks_state() const
+{
+    if (!is_enabled_with_guard(logger::severity::debug))
+    {
+        return;
+    }
+
+    std::string to_dump("|");
+    auto *current_block = reinterpret_cast<unsigned char *>(_trusted_memory) + get_allocator_service_block_size();
+
+    while (true)
+    {
+        size_t current_block_size;
+        if (get_block_occupancy(current_block))
+        {
+            current_block_size = get_occupied_block_size(current_block);
+            if (current_block_size == 0)
+            {
+                break;
+            }
+
+            to_dump += "occ ";
+        }
+        else
+        {
+            current_block_size = get_available_block_size(current_block);
+            to_dump += "avl ";
+        }
+
+        to_dump += std::to_string(current_block_size) + "|";
+        current_block += current_block_size;
+    }
+
+    this->debug_with_guard([&] { return "Memory state: " + to_dump; });
+}
+
+size_t *allocator_tlsf::get_first_level_bitmap_address() const noexcept
+{
+    return reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(_trusted_memory) + first_level_bitmap_offset);
+}
+
+size_t *allocator_tlsf::get_second_level_bitmaps_address() const noexcept
+{
+    return get_first_level_bitmap_address() + 1;
+}
+
+void **allocator_tlsf::get_free_lists_address() const noexcept
+{
+    return reinterpret_cast<void **>(get_second_level_bitmaps_address() + first_level_index_count);
+}
+
+void allocator_tlsf::get_free_list_indices(
+    size_t block_size,
+    size_t &first_level_index,
+    size_t &second_level_index) noexcept
+{
+    if (block_size < static_cast<size_t>(1) << first_level_index_shift)
+    {
+        first_level_index = 0;
+        second_level_index = block_size / ((static_cast<size_t>(1) << first_level_index_shift) / second_level_index_count);
+        return;
+    }
+
+    auto const most_significant_bit_index = bit_operations::find_last_set(block_size);
+
+    first_level_index = most_significant_bit_index - first_level_index_shift + 1;
+    second_level_index = (block_size >> (most_significant_bit_index - second_level_index_count_log2)) ^ second_level_index_count;
+}
+
+void *allocator_tlsf::find_available_block(
+    size_t block_size) const
+{
+    auto const first_level_bitmap = *get_first_level_bitmap_address();
+    auto * const second_level_bitmaps = get_second_level_bitmaps_address();
+    auto * const free_lists = get_free_lists_address();
+
+    if (first_level_bitmap == 0)
+    {
+        return nullptr;
+    }
+
+    size_t first_level_index, second_level_index;
+
+    if (get_allocation_mode() == allocator_fit_allocation::allocation_mode::the_worst_fit)
+    {
+        first_level_index = bit_operations::find_last_set(first_level_bitmap);
+        second_level_index = bit_operations::find_last_set(second_level_bitmaps[first_level_index]);
+
+        // blocks of the highest class may still be smaller than requested size
+        void *target_block = nullptr;
+        for (auto *current_block = free_lists[first_level_index * second_level_index_count + second_level_index]; current_block != nullptr; current_block = get_available_block_next_available_block_address(current_block))
+        {
+            if (target_block == nullptr || get_available_block_size(current_block) > get_available_block_size(target_block))
+            {
+                target_block = current_block;
+            }
+        }
+
+        return get_available_block_size(target_block) >= block_size
+            ? target_block
+            : nullptr;
+    }
+
+    // first fit and the best fit are both served by good fit: the size is rounded up to the next class boundary,
+    // so the head of any non-empty class found by bitmaps fits without scanning the list
+    if (block_size >= static_cast<size_t>(1) << first_level_index_shift)
+    {
+        auto const round_up_addition = (static_cast<size_t>(1) << (bit_operations::find_last_set(block_size) - second_level_index_count_log2)) - 1;
+
+        if (block_size > ~static_cast<size_t>(0) - round_up_addition)
+        {
+            return nullptr;
+        }
+
+        block_size += round_up_addition;
+    }
+
+    get_free_list_indices(block_size, first_level_index, second_level_index);
+
+    auto second_level_bitmap = second_level_bitmaps[first_level_index] & (~static_cast<size_t>(0) << second_level_index);
+
+    if (second_level_bitmap == 0)
+    {
+        auto const greater_first_level_bitmap = first_level_index + 1 == first_level_index_count
+            ? 0
+            : first_level_bitmap & (~static_cast<size_t>(0) << (first_level_index + 1));
+
+        if (greater_first_level_bitmap == 0)
+        {
+            return nullptr;
+        }
+
+        first_level_index = bit_operations::find_first_set(greater_first_level_bitmap);
+        second_level_bitmap = second_level_bitmaps[first_level_index];
+    }
+
+    second_level_index = bit_operations::find_first_set(second_level_bitmap);
+
+    return free_lists[first_level_index * second_level_index_count + second_level_index];
+}
+
+void allocator_tlsf::insert_available_block(
+    void *block_address,
+    size_t block_size)
+{
+    auto * const block_size_address = reinterpret_cast<size_t *>(block_address);
+    *block_size_address = block_size;
+    *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(block_address) + block_size - sizeof(size_t)) = block_size;
+    *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(block_address) + block_size) |= previous_block_availability_flag;
+
+    size_t first_level_index, second_level_index;
+    get_free_list_indices(block_size, first_level_index, second_level_index);
+
+    auto * const free_list_address = get_free_lists_address() + first_level_index * second_level_index_count + second_level_index;
+    auto * const next_available_block = *free_list_address;
+
+    auto * const previous_available_block_address_address = reinterpret_cast<void **>(block_size_address + 1);
+    *previous_available_block_address_address = nullptr;
+    *(previous_available_block_address_address + 1) = next_available_block;
+
+    if (next_available_block != nullptr)
+    {
+        *reinterpret_cast<void **>(reinterpret_cast<size_t *>(next_available_block) + 1) = block_address;
+    }
+
+    *free_list_address = block_address;
+    *get_first_level_bitmap_address() |= static_cast<size_t>(1) << first_level_index;
+    get_second_level_bitmaps_address()[first_level_index] |= static_cast<size_t>(1) << second_level_index;
+}
+
+void allocator_tlsf::remove_available_block(
+    void *block_address)
+{
+    size_t first_level_index, second_level_index;
+    get_free_list_indices(get_available_block_size(block_address), first_level_index, second_level_index);
+
+    auto * const previous_available_block = get_available_block_previous_available_block_address(block_address);
+    auto * const next_available_block = get_available_block_next_available_block_address(block_address);
+
+    if (previous_available_block == nullptr)
+    {
+        get_free_lists_address()[first_level_index * second_level_index_count + second_level_index] = next_available_block;
+
+        if (next_available_block == nullptr)
+        {
+            auto * const second_level_bitmap_address = get_second_level_bitmaps_address() + first_level_index;
+            *second_level_bitmap_address &= ~(static_cast<size_t>(1) << second_level_index);
+
+            if (*second_level_bitmap_address == 0)
+            {
+                *get_first_level_bitmap_address() &= ~(static_cast<size_t>(1) << first_level_index);
+            }
+        }
+    }
+    else
+    {
+        *(reinterpret_cast<void **>(reinterpret_cast<size_t *>(previous_available_block) + 1) + 1) = next_available_block;
+    }
+
+    if (next_available_block != nullptr)
+    {
+        *reinterpret_cast<void **>(reinterpret_cast<size_t *>(next_available_block) + 1) = previous_available_block;
+    }
+}
+
+void allocator_tlsf::set_occupied_block_size(
+    void *block_address,
+    size_t block_size)
+{
+    auto * const block_size_address = reinterpret_cast<size_t *>(block_address);
+    *block_size_address = block_size | block_occupancy_flag | (*block_size_address & previous_block_availability_flag);
+    *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(block_address) + block_size) &= ~previous_block_availability_flag;
+}
+
+size_t allocator_tlsf::get_previous_available_block_size(
+    void const *block_address) const
+{
+    auto const * const block_size_address = reinterpret_cast<size_t const *>(block_address);
+
+    // footer of the previous block is only kept while that block is available
+    return (*block_size_address & previous_block_availability_flag) != 0
+        ? *(block_size_address - 1)
+        : 0;
+}
+
+void *allocator_tlsf::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!is_block_size_supported(requested_block_size, alignment))
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    auto const available_block_service_block_size = get_available_block_service_block_size();
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+
+    auto requested_block_size_overridden = get_aligned_block_size(requested_block_size + occupied_block_service_block_size) - occupied_block_service_block_size;
+    if (requested_block_size_overridden + occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = available_block_service_block_size - occupied_block_service_block_size;
+    }
+
+    // space skipped to align the block is left available, so it should fit an available block
+    auto const alignment_padding_size = alignment > block_alignment
+        ? alignment + available_block_service_block_size
+        : 0;
+
+    auto *target_block = find_available_block(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size);
+
+    if (target_block == nullptr)
+    {
+        target_block = grow(requested_block_size_overridden + occupied_block_service_block_size + alignment_padding_size, lock);
+    }
+
+    if (target_block == nullptr)
+    {
+        this->warning_with_guard("no memory available to allocate");
+
+        return nullptr;
+    }
+
+    auto target_block_size = get_available_block_size(target_block);
+    remove_available_block(target_block);
+
+    auto const aligned_block_offset = get_aligned_block_offset(target_block, sizeof(size_t), alignment, available_block_service_block_size);
+
+    if (aligned_block_offset != 0)
+    {
+        insert_available_block(target_block, aligned_block_offset);
+        target_block = reinterpret_cast<unsigned char *>(target_block) + aligned_block_offset;
+        target_block_size -= aligned_block_offset;
+    }
+
+    if (target_block_size - requested_block_size_overridden - occupied_block_service_block_size < available_block_service_block_size)
+    {
+        requested_block_size_overridden = target_block_size - occupied_block_service_block_size;
+
+        *reinterpret_cast<size_t *>(reinterpret_cast<unsigned char *>(target_block) + target_block_size) &= ~previous_block_availability_flag;
+    }
+    else
+    {
+        insert_available_block(reinterpret_cast<unsigned char *>(target_block) + occupied_block_service_block_size + requested_block_size_overridden,
+            target_block_size - occupied_block_service_block_size - requested_block_size_overridden);
+    }
+
+    if (requested_block_size_overridden != requested_block_size)
+    {
+        this->trace_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes, but reserved " + std::to_string(requested_block_size_overridden) + " bytes in according to correct work of allocator"; });
+
+        requested_block_size = requested_block_size_overridden;
+    }
+
+    auto *target_block_size_address = reinterpret_cast<size_t *>(target_block);
+    // block placed after the space skipped for alignment keeps the previous block availability flag it has got
+    *target_block_size_address = (requested_block_size + occupied_block_service_block_size) | block_occupancy_flag | (*target_block_size_address & previous_block_availability_flag);
+
+    auto * const allocated_block = reinterpret_cast<void *>(target_block_size_address + 1);
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(allocated_block); });
+
+    this->debug_with_guard([&] { return "After `allocate` for " + std::to_string(requested_block_size) + " bytes (addr == " +
+                               address_to_hex(target_block_size_address) + "):"; });
+    dump_trusted_memory_blocks_state();
+    return allocated_block;
+}
+
+void *allocator_tlsf::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto * const allocated_block = allocate_block(requested_block_size, block_alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+void *allocator_tlsf::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
+    {
+        auto const warning_message = "alignment should be a power of 2";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate_block(requested_block_size, alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    if (allocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+void *allocator_tlsf::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    try
+    {
+        return allocate_block(requested_block_size, block_alignment);
+    }
+    catch (...)
+    {
+        // outer allocator may throw while heap grows
+        return nullptr;
+    }
+}
+
+void allocator_tlsf::allocate_batch(
+    size_t requested_block_size,
+    size_t blocks_count,
+    void **allocated_blocks_addresses)
+{
+    allocate_batch_blocks(*get_lock(), requested_block_size, blocks_count, allocated_blocks_addresses);
+}
+
+void allocator_tlsf::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    std::unique_lock<spinlock> lock(*get_lock());
+
+    block_to_deallocate_address = reinterpret_cast<void *>(reinterpret_cast<size_t *>(block_to_deallocate_address) - 1);
+
+    dump_occupied_block_before_deallocate(block_to_deallocate_address, get_logger());
+
+    auto block_to_deallocate_size = get_occupied_block_size(block_to_deallocate_address);
+    auto * const next_block = reinterpret_cast<unsigned char *>(block_to_deallocate_address) + block_to_deallocate_size;
+
+    if ((*reinterpret_cast<size_t *>(block_to_deallocate_address) & previous_block_availability_flag) != 0)
+    {
+        this->trace_with_guard("Merging previous available block with target block...");
+        auto const previous_available_block_size = *(reinterpret_cast<size_t *>(block_to_deallocate_address) - 1);
+        block_to_deallocate_address = reinterpret_cast<unsigned char *>(block_to_deallocate_address) - previous_available_block_size;
+        remove_available_block(block_to_deallocate_address);
+        block_to_deallocate_size += previous_available_block_size;
+        this->trace_with_guard("Merging completed");
+    }
+
+    if (!get_block_occupancy(next_block))
+    {
+        this->trace_with_guard("Merging next available block with target block...");
+        block_to_deallocate_size += get_available_block_size(next_block);
+        remove_available_block(next_block);
+        this->trace_with_guard("Merging completed");
+    }
+
+    auto * const released_chunk = unlink_released_chunk(get_growth_service_block_address(), block_to_deallocate_address, block_to_deallocate_size);
+
+    if (released_chunk == nullptr)
+    {
+        insert_available_block(block_to_deallocate_address, block_to_deallocate_size);
+    }
+
+    this->debug_with_guard([&] { return "After `deallocate` (addr == " + address_to_hex(block_to_deallocate_address) + "):"; });
+    dump_trusted_memory_blocks_state();
+    lock.unlock();
+
+    if (released_chunk != nullptr)
+    {
+        release_chunk(released_chunk);
+    }
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void allocator_tlsf::deallocate_batch(
+    void **blocks_to_deallocate_addresses,
+    size_t blocks_count)
+{
+    deallocate_batch_blocks(*get_lock(), blocks_to_deallocate_addresses, blocks_count);
+}
+
+void *allocator_tlsf::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(new_block_size) + " bytes of memory for block placed at " + address_to_hex(block_to_reallocate_address); });
+
+    auto * const reallocated_block = reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::reallocate(void *block_to_reallocate_address, size_t new_block_size)` execution finished"; });
+
+    if (reallocated_block == nullptr)
+    {
+        throw memory_exception("no memory available to allocate");
+    }
+
+    return reallocated_block;
+}
+
+bool allocator_tlsf::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    auto * const reallocated_block = try_reallocate(*block_to_reallocate_address_address, new_block_size);
+
+    if (reallocated_block == nullptr)
+    {
+        return false;
+    }
+
+    *block_to_reallocate_address_address = reallocated_block;
+    return true;
+}
+
+void *allocator_tlsf::try_reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    try
+    {
+        return reallocate_block(*get_lock(), block_to_reallocate_address, new_block_size);
+    }
+    catch (...)
+    {
+        // outer allocator may throw while heap grows
+        return nullptr;
+    }
+}
+
+void allocator_tlsf::setup_allocation_mode(
+        allocator_fit_allocation::allocation_mode mode)
+{
+    throw_if_next_fit_requested(mode, get_logger());
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    reinterpret_cast<trusted_memory_header *>(_trusted_memory)->allocation_mode = mode;
+}
+
+void allocator_tlsf::setup_growth(
+    size_t chunk_size,
+    size_t free_chunks_high_water_mark)
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    setup_growth_service_block(get_growth_service_block_address(), std::max(chunk_size, get_available_block_service_block_size()), free_chunks_high_water_mark);
+}
+
+spinlock *allocator_tlsf::get_lock() const noexcept
+{
+    return &reinterpret_cast<trusted_memory_header *>(_trusted_memory)->lock;
+}
+
+void *allocator_tlsf::get_growth_service_block_address() const noexcept
+{
+    return reinterpret_cast<unsigned char *>(_trusted_memory) + growth_service_block_offset;
+}
+
+logger *allocator_tlsf::get_logger() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->logger;
+}
+
+std::string allocator_tlsf::get_typename() const noexcept
+{
+    return "allocator_tlsf";
+}
+
+allocator *allocator_tlsf::get_allocator() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->outer_allocator;
+}
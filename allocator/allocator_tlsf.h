@@ -0,0 +1,188 @@
+#ifndef DATA_STRUCTURES_CPP_MEMORY_WITH_TLSF_H
+#define DATA_STRUCTURES_CPP_MEMORY_WITH_TLSF_H
+
+#include <mutex>
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "allocator_fit_allocation.h"
+#include "allocator_holder.h"
+#include "spinlock.h"
+
+class allocator_tlsf final:
+    public allocator_fit_allocation
+{
+
+private:
+
+    void *_trusted_memory;
+
+private:
+
+    static constexpr size_t second_level_index_count_log2 = 4;
+
+    static constexpr size_t second_level_index_count = static_cast<size_t>(1) << second_level_index_count_log2;
+
+    // blocks smaller than 2^first_level_index_shift are linearly split into second level classes of block alignment bytes
+    static constexpr size_t first_level_index_shift = second_level_index_count_log2 + 4;
+
+    static constexpr size_t first_level_index_count = sizeof(size_t) * 8 - first_level_index_shift + 1;
+
+    static constexpr size_t block_occupancy_flag = 1;
+
+    static constexpr size_t previous_block_availability_flag = 2;
+
+    static constexpr size_t block_flags_mask = block_occupancy_flag | previous_block_availability_flag;
+
+    // trusted memory: [header][first level bitmap][second level bitmaps][free lists][growth service block][padding][blocks...][last block next fence]
+    static constexpr size_t first_level_bitmap_offset = sizeof(trusted_memory_header);
+
+    static constexpr size_t growth_service_block_offset = first_level_bitmap_offset + sizeof(size_t) + first_level_index_count * sizeof(size_t) +
+        first_level_index_count * second_level_index_count * sizeof(void *);
+
+    static constexpr size_t first_block_offset = get_first_block_offset(growth_service_block_offset + growth_service_block_size);
+
+public:
+
+    explicit allocator_tlsf(
+        size_t memory_size,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr,
+        allocator_fit_allocation::allocation_mode allocation_mode = allocator_fit_allocation::allocation_mode::first_fit);
+
+    allocator_tlsf(
+        allocator_tlsf const &other) = delete;
+
+    allocator_tlsf &operator=(
+        allocator_tlsf const &other) = delete;
+
+    ~allocator_tlsf() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_trusted_memory_size() const noexcept override;
+
+    [[nodiscard]] allocator_fit_allocation::allocation_mode get_allocation_mode() const noexcept override;
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_available_block_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    [[nodiscard]] bool get_block_occupancy(
+        void const *block_pointer) const override;
+
+    size_t get_available_block_size(
+        void const *current_block_address) const override;
+
+    void *get_available_block_previous_available_block_address(
+        void const *current_block_address) const override;
+
+    void *get_available_block_next_available_block_address(
+        void const *current_block_address) const override;
+
+    size_t get_occupied_block_size(
+        void const *current_block_address) const override;
+
+    void dump_trusted_memory_blocks_state() const override;
+
+private:
+
+    [[nodiscard]] spinlock *get_lock() const noexcept;
+
+    [[nodiscard]] void *get_growth_service_block_address() const noexcept override;
+
+    [[nodiscard]] size_t *get_first_level_bitmap_address() const noexcept;
+
+    [[nodiscard]] size_t *get_second_level_bitmaps_address() const noexcept;
+
+    [[nodiscard]] void **get_free_lists_address() const noexcept;
+
+    static void get_free_list_indices(
+        size_t block_size,
+        size_t &first_level_index,
+        size_t &second_level_index) noexcept;
+
+    [[nodiscard]] void *find_available_block(
+        size_t block_size) const override;
+
+    void insert_available_block(
+        void *block_address,
+        size_t block_size) override;
+
+    void remove_available_block(
+        void *block_address) override;
+
+    [[nodiscard]] void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    void set_occupied_block_size(
+        void *block_address,
+        size_t block_size) override;
+
+    [[nodiscard]] size_t get_previous_available_block_size(
+        void const *block_address) const override;
+
+public:
+
+    void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    [[nodiscard]] void *try_allocate(
+        size_t requested_block_size) noexcept override;
+
+    [[nodiscard]] void *try_reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) noexcept override;
+
+    void allocate_batch(
+        size_t requested_block_size,
+        size_t blocks_count,
+        void **allocated_blocks_addresses) override;
+
+    void deallocate_batch(
+        void **blocks_to_deallocate_addresses,
+        size_t blocks_count) override;
+
+public:
+
+    void setup_allocation_mode(
+        allocator_fit_allocation::allocation_mode mode) override;
+
+    void setup_growth(
+        size_t chunk_size,
+        size_t free_chunks_high_water_mark) override;
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+private:
+
+    [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_MEMORY_WITH_TLSF_H
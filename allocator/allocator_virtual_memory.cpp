@@ -0,0 +1,420 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "allocator_virtual_memory.h"
+
+allocator_virtual_memory::allocator_virtual_memory(
+    size_t reserved_size,
+    size_t decommit_threshold,
+    logger *log)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested reserved size: " + std::to_string(reserved_size) + " bytes, decommit threshold: " + std::to_string(decommit_threshold) + " bytes");
+    }
+
+    auto const page_size = get_page_size();
+    reserved_size = (reserved_size + page_size - 1) / page_size * page_size;
+
+    // reserved range is neither accessible nor accounted as committed until pages are placed in use
+    auto * const reserved_memory = mmap(nullptr, reserved_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (reserved_size == 0 || reserved_memory == MAP_FAILED)
+    {
+        auto error_message = "can't reserve " + std::to_string(reserved_size) + " bytes of virtual memory";
+
+        if (log != nullptr)
+        {
+            log->error(error_message);
+        }
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    _trusted_memory = ::operator new(get_allocator_service_block_size());
+
+    auto * const reserved_size_space = reinterpret_cast<size_t *>(_trusted_memory);
+    *reserved_size_space = reserved_size;
+
+    auto * const decommit_threshold_space = reserved_size_space + 1;
+    *decommit_threshold_space = std::max(decommit_threshold, page_size);
+
+    auto * const logger_pointer_space = reinterpret_cast<logger **>(decommit_threshold_space + 1);
+    *logger_pointer_space = log;
+
+    new (get_lock()) spinlock();
+
+    auto * const reserved_memory_pointer_space = reinterpret_cast<unsigned char **>(reinterpret_cast<unsigned char *>(get_lock()) + sizeof(spinlock));
+    *reserved_memory_pointer_space = reinterpret_cast<unsigned char *>(reserved_memory);
+
+    *get_committed_top_address() = reinterpret_cast<unsigned char *>(reserved_memory);
+    *get_first_available_block_address_address() = nullptr;
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+allocator_virtual_memory::~allocator_virtual_memory() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    munmap(get_reserved_memory(), get_trusted_memory_size());
+    ::operator delete(_trusted_memory);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t allocator_virtual_memory::get_trusted_memory_size() const noexcept
+{
+    return *reinterpret_cast<size_t *>(_trusted_memory);
+}
+
+size_t allocator_virtual_memory::get_allocator_service_block_size() const noexcept
+{
+    auto const reserved_size_size = sizeof(size_t);
+    auto const decommit_threshold_size = sizeof(size_t);
+    auto const logger_pointer_size = sizeof(logger *);
+    auto const lock_size = sizeof(spinlock);
+    auto const reserved_memory_pointer_size = sizeof(void *);
+    auto const committed_top_pointer_size = sizeof(void *);
+    auto const first_available_span_pointer_size = sizeof(void *);
+
+    return reserved_size_size + decommit_threshold_size + logger_pointer_size + lock_size + reserved_memory_pointer_size + committed_top_pointer_size + first_available_span_pointer_size;
+}
+
+size_t allocator_virtual_memory::get_occupied_block_service_block_size() const noexcept
+{
+    // two words keep blocks aligned to 16 bytes
+    auto const span_size_size = sizeof(size_t);
+    auto const block_size_size = sizeof(size_t);
+
+    return span_size_size + block_size_size;
+}
+
+void **allocator_virtual_memory::get_first_available_block_address_address() const noexcept
+{
+    return reinterpret_cast<void **>(get_committed_top_address() + 1);
+}
+
+void *allocator_virtual_memory::get_first_available_block_address() const noexcept
+{
+    return *get_first_available_block_address_address();
+}
+
+size_t allocator_virtual_memory::get_available_block_size(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<size_t const *>(current_block_address);
+}
+
+void *allocator_virtual_memory::get_available_block_next_available_block_address(
+    void const *current_block_address) const
+{
+    return *reinterpret_cast<void * const *>(reinterpret_cast<size_t const *>(current_block_address) + 1);
+}
+
+size_t allocator_virtual_memory::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *(reinterpret_cast<size_t const *>(current_block_address) + 1);
+}
+
+size_t allocator_virtual_memory::get_decommit_threshold() const noexcept
+{
+    return *(reinterpret_cast<size_t *>(_trusted_memory) + 1);
+}
+
+spinlock *allocator_virtual_memory::get_lock() const noexcept
+{
+    return reinterpret_cast<spinlock *>(reinterpret_cast<unsigned char *>(_trusted_memory) + sizeof(size_t) + sizeof(size_t) + sizeof(logger *));
+}
+
+unsigned char *allocator_virtual_memory::get_reserved_memory() const noexcept
+{
+    return *reinterpret_cast<unsigned char **>(reinterpret_cast<unsigned char *>(get_lock()) + sizeof(spinlock));
+}
+
+unsigned char **allocator_virtual_memory::get_committed_top_address() const noexcept
+{
+    return reinterpret_cast<unsigned char **>(reinterpret_cast<unsigned char *>(get_lock()) + sizeof(spinlock)) + 1;
+}
+
+size_t allocator_virtual_memory::get_page_size() noexcept
+{
+    static size_t const page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    return page_size;
+}
+
+bool allocator_virtual_memory::commit(
+    void *span_address,
+    size_t span_size) noexcept
+{
+    return span_size == 0 || mprotect(span_address, span_size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void allocator_virtual_memory::decommit(
+    void *span_address,
+    size_t span_size) noexcept
+{
+    if (span_size == 0)
+    {
+        return;
+    }
+
+    // pages are dropped from resident set and made inaccessible again, so stale pointers fault instead of reading zeroes
+    madvise(span_address, span_size, MADV_DONTNEED);
+    mprotect(span_address, span_size, PROT_NONE);
+}
+
+unsigned char *allocator_virtual_memory::get_span_address(
+    void const *block_data_address) const noexcept
+{
+    // header of a block aligned up to the page size still lies on the first page of the span
+    auto const page_size = get_page_size();
+    auto const block_address = reinterpret_cast<uintptr_t>(block_data_address) - get_occupied_block_service_block_size();
+
+    return reinterpret_cast<unsigned char *>(block_address / page_size * page_size);
+}
+
+void *allocator_virtual_memory::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+    auto const block_data_offset = std::max(occupied_block_service_block_size, alignment);
+    auto const page_size = get_page_size();
+    auto const decommit_threshold = get_decommit_threshold();
+    auto const span_size = (block_data_offset + requested_block_size + page_size - 1) / page_size * page_size;
+
+    // released spans are kept sorted by address; every span of decommit threshold size or greater has only its
+    // first page committed, smaller spans stay committed entirely
+    auto **span_address_address = get_first_available_block_address_address();
+    while (*span_address_address != nullptr && get_available_block_size(*span_address_address) < span_size)
+    {
+        span_address_address = reinterpret_cast<void **>(reinterpret_cast<size_t *>(*span_address_address) + 1);
+    }
+
+    unsigned char *span;
+
+    if (*span_address_address == nullptr)
+    {
+        auto ** const committed_top_address = get_committed_top_address();
+        span = *committed_top_address;
+
+        if (span_size > static_cast<size_t>(get_reserved_memory() + get_trusted_memory_size() - span) || !commit(span, span_size))
+        {
+            auto const warning_message = "no memory available to allocate";
+
+            this->warning_with_guard(warning_message);
+
+            throw memory_exception(warning_message);
+        }
+
+        *committed_top_address += span_size;
+    }
+    else
+    {
+        span = reinterpret_cast<unsigned char *>(*span_address_address);
+        auto const available_span_size = get_available_block_size(span);
+        auto const remaining_span_size = available_span_size - span_size;
+        auto * const remaining_span = span + span_size;
+        auto const is_decommitted = available_span_size >= decommit_threshold;
+
+        if (is_decommitted && !commit(span, remaining_span_size == 0
+            ? span_size
+            : remaining_span_size < decommit_threshold
+                ? available_span_size
+                : span_size + page_size))
+        {
+            auto const warning_message = "no memory available to allocate";
+
+            this->warning_with_guard(warning_message);
+
+            throw memory_exception(warning_message);
+        }
+
+        if (remaining_span_size == 0)
+        {
+            *span_address_address = get_available_block_next_available_block_address(span);
+        }
+        else
+        {
+            *reinterpret_cast<size_t *>(remaining_span) = remaining_span_size;
+            *reinterpret_cast<void **>(reinterpret_cast<size_t *>(remaining_span) + 1) = get_available_block_next_available_block_address(span);
+            *span_address_address = remaining_span;
+        }
+    }
+
+    auto * const block = reinterpret_cast<size_t *>(span + block_data_offset - occupied_block_service_block_size);
+    *block = span_size;
+    *(block + 1) = requested_block_size;
+
+    this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(block) + " in span of " + std::to_string(span_size) + " bytes"; });
+
+    return block + 2;
+}
+
+void *allocator_virtual_memory::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto * const allocated_block = allocate_block(requested_block_size, sizeof(size_t));
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    return allocated_block;
+}
+
+void allocator_virtual_memory::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    std::lock_guard<spinlock> lock(*get_lock());
+
+    auto const page_size = get_page_size();
+    auto *span = get_span_address(block_to_deallocate_address);
+    auto span_size = *(reinterpret_cast<size_t *>(block_to_deallocate_address) - 2);
+
+    void **previous_span_address_address = nullptr;
+    auto **span_address_address = get_first_available_block_address_address();
+    while (*span_address_address != nullptr && *span_address_address < span)
+    {
+        previous_span_address_address = span_address_address;
+        span_address_address = reinterpret_cast<void **>(reinterpret_cast<size_t *>(*span_address_address) + 1);
+    }
+
+    auto * const next_span = reinterpret_cast<unsigned char *>(*span_address_address);
+
+    if (next_span == span + span_size)
+    {
+        span_size += get_available_block_size(next_span);
+        *span_address_address = get_available_block_next_available_block_address(next_span);
+    }
+
+    if (previous_span_address_address != nullptr)
+    {
+        auto * const previous_span = reinterpret_cast<unsigned char *>(*previous_span_address_address);
+        auto const previous_span_size = get_available_block_size(previous_span);
+
+        if (previous_span + previous_span_size == span)
+        {
+            span = previous_span;
+            span_size += previous_span_size;
+            *previous_span_address_address = *span_address_address;
+            span_address_address = previous_span_address_address;
+        }
+    }
+
+    auto ** const committed_top_address = get_committed_top_address();
+
+    if (span + span_size == *committed_top_address)
+    {
+        // span on top of committed memory just lowers the top
+        decommit(span, span_size);
+        *committed_top_address = span;
+
+        this->debug_with_guard([&] { return "Committed top lowered to " + address_to_hex(span); });
+    }
+    else
+    {
+        if (span_size >= get_decommit_threshold())
+        {
+            decommit(span + page_size, span_size - page_size);
+
+            this->debug_with_guard([&] { return "Span of " + std::to_string(span_size) + " bytes placed at " + address_to_hex(span) + " decommitted"; });
+        }
+
+        *reinterpret_cast<size_t *>(span) = span_size;
+        *reinterpret_cast<void **>(reinterpret_cast<size_t *>(span) + 1) = *span_address_address;
+        *span_address_address = span;
+    }
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void *allocator_virtual_memory::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    auto * const block = reinterpret_cast<size_t *>(block_to_reallocate_address) - 2;
+
+    // tail of the span is already committed
+    if (static_cast<size_t>(reinterpret_cast<unsigned char *>(block_to_reallocate_address) - get_span_address(block_to_reallocate_address)) + new_block_size <= *block)
+    {
+        *(block + 1) = new_block_size;
+
+        return block_to_reallocate_address;
+    }
+
+    auto * const new_block = allocate(new_block_size);
+    memcpy(new_block, block_to_reallocate_address, std::min(get_occupied_block_size(block), new_block_size));
+    deallocate(block_to_reallocate_address);
+
+    return new_block;
+}
+
+bool allocator_virtual_memory::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    try {
+        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
+        return true;
+    }
+    catch (std::exception const &ex)
+    {
+        this->warning_with_guard(ex.what());
+        return false;
+    }
+}
+
+void *allocator_virtual_memory::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment) || alignment > get_page_size())
+    {
+        auto const warning_message = "alignment should be a power of 2 not GT page size";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate_block(requested_block_size, alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    return allocated_block;
+}
+
+logger *allocator_virtual_memory::get_logger() const noexcept
+{
+    return *reinterpret_cast<logger **>(reinterpret_cast<size_t *>(_trusted_memory) + 2);
+}
+
+std::string allocator_virtual_memory::get_typename() const noexcept
+{
+    return "allocator_virtual_memory";
+}
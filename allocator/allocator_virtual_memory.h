@@ -0,0 +1,117 @@
+#ifndef DATA_STRUCTURES_CPP_ALLOCATOR_VIRTUAL_MEMORY_H
+#define DATA_STRUCTURES_CPP_ALLOCATOR_VIRTUAL_MEMORY_H
+
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "spinlock.h"
+
+// reserves a virtual range without committing it and commits pages only when blocks are placed on them; released
+// spans of at least decommit threshold bytes are given back to the kernel. Passed as outer allocator to growable
+// engines, it makes their resident memory follow actual use instead of the reserved peak
+class allocator_virtual_memory final:
+    public allocator,
+    protected logger_holder,
+    protected typename_holder
+{
+
+private:
+
+    void *_trusted_memory;
+
+public:
+
+    explicit allocator_virtual_memory(
+        size_t reserved_size,
+        size_t decommit_threshold = 1024 * 1024,
+        logger *logger = nullptr);
+
+    allocator_virtual_memory(
+        allocator_virtual_memory const &other) = delete;
+
+    allocator_virtual_memory &operator=(
+        allocator_virtual_memory const &other) = delete;
+
+    ~allocator_virtual_memory() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_trusted_memory_size() const noexcept override;
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    [[nodiscard]] void **get_first_available_block_address_address() const noexcept override;
+
+    [[nodiscard]] void *get_first_available_block_address() const noexcept override;
+
+    size_t get_available_block_size(
+        void const *current_block_address) const override;
+
+    void *get_available_block_next_available_block_address(
+        void const *current_block_address) const override;
+
+    size_t get_occupied_block_size(
+        void const *current_block_address) const override;
+
+private:
+
+    [[nodiscard]] size_t get_decommit_threshold() const noexcept;
+
+    [[nodiscard]] spinlock *get_lock() const noexcept;
+
+    [[nodiscard]] unsigned char *get_reserved_memory() const noexcept;
+
+    [[nodiscard]] unsigned char **get_committed_top_address() const noexcept;
+
+    [[nodiscard]] static size_t get_page_size() noexcept;
+
+    [[nodiscard]] static bool commit(
+        void *span_address,
+        size_t span_size) noexcept;
+
+    static void decommit(
+        void *span_address,
+        size_t span_size) noexcept;
+
+    [[nodiscard]] unsigned char *get_span_address(
+        void const *block_data_address) const noexcept;
+
+    [[nodiscard]] void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment);
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    // alignment is limited by the page size
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_ALLOCATOR_VIRTUAL_MEMORY_H
@@ -0,0 +1,1248 @@
+#ifndef DATA_STRUCTURES_CPP_BASIC_FIT_ALLOCATOR_H
+#define DATA_STRUCTURES_CPP_BASIC_FIT_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include "logger.h"
+#include "allocator.h"
+#include "allocator_fit_allocation.h"
+#include "spinlock.h"
+
+// fit policy decides which of the available blocks large enough to allocate from is taken
+struct first_fit_policy final
+{
+
+    static constexpr allocator_fit_allocation::allocation_mode allocation_mode = allocator_fit_allocation::allocation_mode::first_fit;
+
+    static constexpr bool stops_at_first_fitting_block = true;
+
+    static constexpr bool stops_at_exactly_fitting_block = true;
+
+    static constexpr bool is_better(
+        size_t,
+        size_t) noexcept
+    {
+        return false;
+    }
+
+};
+
+struct the_best_fit_policy final
+{
+
+    static constexpr allocator_fit_allocation::allocation_mode allocation_mode = allocator_fit_allocation::allocation_mode::the_best_fit;
+
+    static constexpr bool stops_at_first_fitting_block = false;
+
+    // no block fits better than the one of exactly requested size
+    static constexpr bool stops_at_exactly_fitting_block = true;
+
+    static constexpr bool is_better(
+        size_t candidate_block_size,
+        size_t target_block_size) noexcept
+    {
+        return candidate_block_size < target_block_size;
+    }
+
+};
+
+struct the_worst_fit_policy final
+{
+
+    static constexpr allocator_fit_allocation::allocation_mode allocation_mode = allocator_fit_allocation::allocation_mode::the_worst_fit;
+
+    static constexpr bool stops_at_first_fitting_block = false;
+
+    static constexpr bool stops_at_exactly_fitting_block = false;
+
+    static constexpr bool is_better(
+        size_t candidate_block_size,
+        size_t target_block_size) noexcept
+    {
+        return candidate_block_size > target_block_size;
+    }
+
+};
+
+// lock policy is any Lockable type placed into trusted memory (spinlock, robust_mutex), or this one for heaps
+// used by a single thread
+struct no_lock_policy final
+{
+
+    void lock() noexcept
+    {
+
+    }
+
+    [[nodiscard]] bool try_lock() noexcept
+    {
+        return true;
+    }
+
+    void unlock() noexcept
+    {
+
+    }
+
+};
+
+// log policy gets message builders, which are called only for the messages to be logged
+struct no_log_policy
+{
+
+    explicit no_log_policy(
+        logger * = nullptr) noexcept
+    {
+
+    }
+
+    [[nodiscard]] static constexpr bool is_enabled(
+        logger::severity) noexcept
+    {
+        return false;
+    }
+
+    template<
+        typename message_builder_type>
+    static void log(
+        message_builder_type const &,
+        logger::severity) noexcept
+    {
+
+    }
+
+};
+
+class logger_log_policy
+{
+
+private:
+
+    logger *_logger;
+
+public:
+
+    explicit logger_log_policy(
+        logger *logger = nullptr) noexcept:
+        _logger(logger)
+    {
+
+    }
+
+    [[nodiscard]] bool is_enabled(
+        [[maybe_unused]] logger::severity severity) const noexcept
+    {
+#ifdef LOGGER_HOLDER_DISABLE_LOGGING
+        return false;
+#else
+        return _logger != nullptr && _logger->is_enabled(severity);
+#endif
+    }
+
+    template<
+        typename message_builder_type>
+    void log(
+        message_builder_type const &build_message,
+        logger::severity severity) const
+    {
+        if (is_enabled(severity))
+        {
+            _logger->log(build_message(), severity);
+        }
+    }
+
+};
+
+// backing policy provides trusted memory aligned as requested
+struct new_delete_backing_policy
+{
+
+    explicit new_delete_backing_policy(
+        allocator * = nullptr) noexcept
+    {
+
+    }
+
+    [[nodiscard]] static void *allocate(
+        size_t size,
+        size_t alignment)
+    {
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+
+    static void deallocate(
+        void *memory,
+        size_t alignment) noexcept
+    {
+        ::operator delete(memory, std::align_val_t(alignment));
+    }
+
+};
+
+class allocator_backing_policy
+{
+
+private:
+
+    allocator *_outer_allocator;
+
+public:
+
+    explicit allocator_backing_policy(
+        allocator *outer_allocator = nullptr) noexcept:
+        _outer_allocator(outer_allocator)
+    {
+
+    }
+
+    [[nodiscard]] void *allocate(
+        size_t size,
+        size_t alignment) const
+    {
+        return _outer_allocator == nullptr
+            ? ::operator new(size, std::align_val_t(alignment))
+            : _outer_allocator->allocate_aligned(size, alignment);
+    }
+
+    void deallocate(
+        void *memory,
+        size_t alignment) const
+    {
+        _outer_allocator == nullptr
+            ? ::operator delete(memory, std::align_val_t(alignment))
+            : _outer_allocator->deallocate(memory);
+    }
+
+};
+
+// block header policy decides how boundary tags and links between available blocks are stored
+struct native_block_header_policy final
+{
+
+    using boundary_tag_type = size_t;
+
+    using link_type = void *;
+
+    // limit for the offset of any byte of trusted memory
+    static constexpr size_t addressable_memory_size = std::numeric_limits<size_t>::max();
+
+    static constexpr link_type null_link = nullptr;
+
+    [[nodiscard]] static link_type to_link(
+        void *,
+        void *block_address) noexcept
+    {
+        return block_address;
+    }
+
+    [[nodiscard]] static void *from_link(
+        void *,
+        link_type link) noexcept
+    {
+        return link;
+    }
+
+    // same as from_link for links other than null_link
+    [[nodiscard]] static void *get_linked_block_address(
+        void *,
+        link_type link) noexcept
+    {
+        return link;
+    }
+
+};
+
+// 32-bit boundary tags and links stored as offsets from trusted memory start, which halves service data of
+// every block for heaps smaller than 4 GiB. Offset 0 is inside of allocator service block, so it never refers
+// to a block and stands for nullptr
+struct compact_block_header_policy final
+{
+
+    using boundary_tag_type = uint32_t;
+
+    using link_type = uint32_t;
+
+    static constexpr size_t addressable_memory_size = std::numeric_limits<uint32_t>::max();
+
+    static constexpr link_type null_link = 0;
+
+    [[nodiscard]] static link_type to_link(
+        void *trusted_memory,
+        void *block_address) noexcept
+    {
+        return block_address == nullptr
+            ? null_link
+            : static_cast<link_type>(reinterpret_cast<unsigned char *>(block_address) - reinterpret_cast<unsigned char *>(trusted_memory));
+    }
+
+    [[nodiscard]] static void *from_link(
+        void *trusted_memory,
+        link_type link) noexcept
+    {
+        return link == null_link
+            ? nullptr
+            : get_linked_block_address(trusted_memory, link);
+    }
+
+    [[nodiscard]] static void *get_linked_block_address(
+        void *trusted_memory,
+        link_type link) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(trusted_memory) + link;
+    }
+
+};
+
+// fit allocator with fit mode, lock, logging, trusted memory source and block header format chosen at compile
+// time, so nothing on its hot path is dispatched virtually; layout matches allocator_descriptor: trusted memory
+// starts with allocator_fit_allocation's header, blocks carry boundary tags with occupancy in the lowest bit,
+// available blocks are linked into a list by links placed after the header. Block sizes are multiple of
+// allocator_fit_allocation::block_alignment and blocks are placed so that their data is aligned to it whatever
+// the boundary tag size is.
+// Defaults behave as allocator_descriptor in first fit mode without growth
+template<
+    typename fit_policy = first_fit_policy,
+    typename lock_policy = spinlock,
+    typename log_policy = logger_log_policy,
+    typename backing_policy = allocator_backing_policy,
+    typename block_header_policy = native_block_header_policy>
+class basic_fit_allocator final:
+    private log_policy,
+    private backing_policy
+{
+
+private:
+
+    using boundary_tag_type = typename block_header_policy::boundary_tag_type;
+
+    using link_type = typename block_header_policy::link_type;
+
+    using trusted_memory_header = allocator_fit_allocation::basic_trusted_memory_header<lock_policy>;
+
+    static constexpr size_t block_alignment = allocator_fit_allocation::block_alignment;
+
+    static constexpr size_t block_occupancy_flag = 1;
+
+    static constexpr size_t occupied_block_header_size = sizeof(boundary_tag_type);
+
+    static constexpr size_t occupied_block_service_block_size = 2 * sizeof(boundary_tag_type);
+
+    static constexpr size_t available_block_service_block_size = 2 * sizeof(boundary_tag_type) + 2 * sizeof(link_type);
+
+    // tail of a block is split off only if it could hold an available block with native headers: smaller tails left
+    // by compact headers would lengthen the available list scanned by every allocation
+    static constexpr size_t split_block_size_threshold = allocator_fit_allocation::get_aligned_block_size(2 * sizeof(size_t) + 2 * sizeof(void *));
+
+    static constexpr size_t minimal_block_size = allocator_fit_allocation::get_aligned_block_size(available_block_service_block_size);
+
+    // trusted memory: [header][first available block address][padding][first block previous fence][blocks...][last block next fence]
+    static constexpr size_t first_available_block_address_offset = sizeof(trusted_memory_header);
+
+    static constexpr size_t allocator_service_block_size = allocator_fit_allocation::get_first_block_offset(first_available_block_address_offset + sizeof(void *) + sizeof(boundary_tag_type), occupied_block_header_size);
+
+    static_assert(alignof(trusted_memory_header) <= allocator_fit_allocation::cache_line_size, "lock policy type should not be over-aligned");
+
+    static_assert(block_alignment % alignof(boundary_tag_type) == 0 && occupied_block_header_size % alignof(link_type) == 0, "block header policy types can't be placed into blocks");
+
+private:
+
+    void *_trusted_memory;
+
+public:
+
+    explicit basic_fit_allocator(
+        size_t memory_size,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr);
+
+    basic_fit_allocator(
+        basic_fit_allocator const &other) = delete;
+
+    basic_fit_allocator &operator=(
+        basic_fit_allocator const &other) = delete;
+
+    ~basic_fit_allocator() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_trusted_memory_size() const noexcept;
+
+    [[nodiscard]] lock_policy *get_lock() const noexcept;
+
+    [[nodiscard]] void **get_first_available_block_address_address() const noexcept;
+
+    [[nodiscard]] static bool get_block_occupancy(
+        void const *block_address) noexcept;
+
+    [[nodiscard]] static size_t get_block_size(
+        void const *block_address) noexcept;
+
+    [[nodiscard]] static link_type *get_available_block_links(
+        void *block_address) noexcept;
+
+    [[nodiscard]] void *get_available_block_previous_available_block_address(
+        void *block_address) const noexcept;
+
+    [[nodiscard]] void *get_available_block_next_available_block_address(
+        void *block_address) const noexcept;
+
+    void set_available_block_previous_available_block_address(
+        void *block_address,
+        void *previous_available_block_address) const noexcept;
+
+    void set_available_block_next_available_block_address(
+        void *block_address,
+        void *next_available_block_address) const noexcept;
+
+    static void set_block_boundary_tags(
+        void *block_address,
+        size_t block_size,
+        bool block_occupancy) noexcept;
+
+    // same as allocator::get_aligned_block_offset, which is out of reach here
+    [[nodiscard]] static size_t get_aligned_block_offset(
+        void const *block_address,
+        size_t alignment) noexcept;
+
+    [[nodiscard]] static size_t get_overridden_block_size(
+        size_t requested_block_size) noexcept;
+
+    [[nodiscard]] static std::string address_to_hex(
+        void const *pointer);
+
+    void insert_available_block(
+        void *block_address,
+        size_t block_size) noexcept;
+
+    void remove_available_block(
+        void *block_address) noexcept;
+
+    [[nodiscard]] void *find_available_block(
+        size_t block_size) const noexcept;
+
+    // returns nullptr if there is no memory available to allocate
+    [[nodiscard]] void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment);
+
+    // shrinks block in place or grows it into the next available block; lock should be held by caller
+    bool resize_block(
+        void *block_address,
+        size_t new_block_size) noexcept;
+
+    // returns nullptr if block can't be resized in place and there is no memory available to move it
+    [[nodiscard]] void *reallocate_block(
+        void *block_to_reallocate_address,
+        size_t new_block_size);
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size);
+
+    void deallocate(
+        void *block_to_deallocate_address);
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size);
+
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment);
+
+    [[nodiscard]] void *try_allocate(
+        size_t requested_block_size) noexcept;
+
+    [[nodiscard]] void *try_reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) noexcept;
+
+};
+
+// runtime-polymorphic face of basic_fit_allocator for the code working with allocator *; virtual dispatch
+// happens once per call, the engine itself is inlined into the overrides
+template<
+    typename basic_fit_allocator_type>
+class fit_allocator_adapter final:
+    public allocator
+{
+
+private:
+
+    basic_fit_allocator_type _allocator;
+
+public:
+
+    explicit fit_allocator_adapter(
+        size_t memory_size,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr);
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+    [[nodiscard]] void *try_allocate(
+        size_t requested_block_size) noexcept override;
+
+    [[nodiscard]] void *try_reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) noexcept override;
+
+};
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::basic_fit_allocator(
+    size_t memory_size,
+    allocator *outer_allocator,
+    logger *log):
+    log_policy(log),
+    backing_policy(outer_allocator)
+{
+    log_policy::log([] { return std::string("basic_fit_allocator allocator instance construction started"); }, logger::severity::trace);
+
+    // block sizes are kept multiple of block alignment, so the lowest bit of boundary tags holds block occupancy
+    memory_size = memory_size / block_alignment * block_alignment;
+
+    if (memory_size < minimal_block_size)
+    {
+        auto const error_message = "trusted memory size should be GT " + std::to_string(minimal_block_size) + " bytes";
+
+        log_policy::log([&error_message] { return error_message; }, logger::severity::error);
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    if (memory_size > block_header_policy::addressable_memory_size - allocator_service_block_size - sizeof(boundary_tag_type))
+    {
+        auto const error_message = "trusted memory size should be LT " + std::to_string(block_header_policy::addressable_memory_size - allocator_service_block_size - sizeof(boundary_tag_type)) + " bytes";
+
+        log_policy::log([&error_message] { return error_message; }, logger::severity::error);
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    _trusted_memory = backing_policy::allocate(allocator_service_block_size + memory_size + sizeof(boundary_tag_type), allocator_fit_allocation::cache_line_size);
+
+    auto *const header = new (_trusted_memory) trusted_memory_header();
+    header->allocation_mode = fit_policy::allocation_mode;
+    header->logger = log;
+    header->memory_size = memory_size;
+    header->outer_allocator = outer_allocator;
+
+    *get_first_available_block_address_address() = nullptr;
+
+    // occupied zero-sized footer before the first block and header after the last one stop neighbours lookup
+    auto *const first_block = reinterpret_cast<unsigned char *>(_trusted_memory) + allocator_service_block_size;
+    *(reinterpret_cast<boundary_tag_type *>(first_block) - 1) = block_occupancy_flag;
+    *reinterpret_cast<boundary_tag_type *>(first_block + memory_size) = block_occupancy_flag;
+
+    insert_available_block(first_block, memory_size);
+
+    log_policy::log([] { return std::string("basic_fit_allocator allocator instance construction finished"); }, logger::severity::trace);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::~basic_fit_allocator() noexcept
+{
+    log_policy::log([] { return std::string("basic_fit_allocator allocator instance destruction started"); }, logger::severity::trace);
+
+    get_lock()->~lock_policy();
+    backing_policy::deallocate(_trusted_memory, allocator_fit_allocation::cache_line_size);
+
+    log_policy::log([] { return std::string("basic_fit_allocator allocator instance destruction finished"); }, logger::severity::trace);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+size_t basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_trusted_memory_size() const noexcept
+{
+    return reinterpret_cast<trusted_memory_header *>(_trusted_memory)->memory_size;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+lock_policy *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_lock() const noexcept
+{
+    return &reinterpret_cast<trusted_memory_header *>(_trusted_memory)->lock;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void **basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_first_available_block_address_address() const noexcept
+{
+    return reinterpret_cast<void **>(reinterpret_cast<unsigned char *>(_trusted_memory) + first_available_block_address_offset);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+bool basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_block_occupancy(
+    void const *block_address) noexcept
+{
+    return (*reinterpret_cast<boundary_tag_type const *>(block_address) & block_occupancy_flag) != 0;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+size_t basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_block_size(
+    void const *block_address) noexcept
+{
+    return *reinterpret_cast<boundary_tag_type const *>(block_address) & ~block_occupancy_flag;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+typename basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::link_type *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_available_block_links(
+    void *block_address) noexcept
+{
+    return reinterpret_cast<link_type *>(reinterpret_cast<boundary_tag_type *>(block_address) + 1);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_available_block_previous_available_block_address(
+    void *block_address) const noexcept
+{
+    return block_header_policy::from_link(_trusted_memory, get_available_block_links(block_address)[0]);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_available_block_next_available_block_address(
+    void *block_address) const noexcept
+{
+    return block_header_policy::from_link(_trusted_memory, get_available_block_links(block_address)[1]);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::set_available_block_previous_available_block_address(
+    void *block_address,
+    void *previous_available_block_address) const noexcept
+{
+    get_available_block_links(block_address)[0] = block_header_policy::to_link(_trusted_memory, previous_available_block_address);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::set_available_block_next_available_block_address(
+    void *block_address,
+    void *next_available_block_address) const noexcept
+{
+    get_available_block_links(block_address)[1] = block_header_policy::to_link(_trusted_memory, next_available_block_address);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::set_block_boundary_tags(
+    void *block_address,
+    size_t block_size,
+    bool block_occupancy) noexcept
+{
+    auto const boundary_tag = static_cast<boundary_tag_type>(block_occupancy
+        ? block_size | block_occupancy_flag
+        : block_size);
+
+    *reinterpret_cast<boundary_tag_type *>(block_address) = boundary_tag;
+    *reinterpret_cast<boundary_tag_type *>(reinterpret_cast<unsigned char *>(block_address) + block_size - sizeof(boundary_tag_type)) = boundary_tag;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+size_t basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_aligned_block_offset(
+    void const *block_address,
+    size_t alignment) noexcept
+{
+    auto const block_data_address = reinterpret_cast<uintptr_t>(block_address) + occupied_block_header_size;
+    auto offset = ((block_data_address + alignment - 1) & ~(alignment - 1)) - block_data_address;
+
+    if (offset != 0 && offset < available_block_service_block_size)
+    {
+        offset += (available_block_service_block_size - offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    return offset;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+size_t basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::get_overridden_block_size(
+    size_t requested_block_size) noexcept
+{
+    auto const block_size = allocator_fit_allocation::get_aligned_block_size(requested_block_size + occupied_block_service_block_size);
+
+    return std::max(block_size, minimal_block_size);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+std::string basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::address_to_hex(
+    void const *pointer)
+{
+    return std::string { (std::stringstream() << pointer).str() };
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::insert_available_block(
+    void *block_address,
+    size_t block_size) noexcept
+{
+    set_block_boundary_tags(block_address, block_size, false);
+
+    auto *const first_available_block_address_address = get_first_available_block_address_address();
+    auto *const next_available_block = *first_available_block_address_address;
+
+    set_available_block_previous_available_block_address(block_address, nullptr);
+    set_available_block_next_available_block_address(block_address, next_available_block);
+
+    if (next_available_block != nullptr)
+    {
+        set_available_block_previous_available_block_address(next_available_block, block_address);
+    }
+
+    *first_available_block_address_address = block_address;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::remove_available_block(
+    void *block_address) noexcept
+{
+    auto *const previous_available_block = get_available_block_previous_available_block_address(block_address);
+    auto *const next_available_block = get_available_block_next_available_block_address(block_address);
+
+    if (previous_available_block == nullptr)
+    {
+        *get_first_available_block_address_address() = next_available_block;
+    }
+    else
+    {
+        set_available_block_next_available_block_address(previous_available_block, next_available_block);
+    }
+
+    if (next_available_block != nullptr)
+    {
+        set_available_block_previous_available_block_address(next_available_block, previous_available_block);
+    }
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::find_available_block(
+    size_t block_size) const noexcept
+{
+    void *target_block = nullptr;
+    size_t target_block_size = 0;
+
+    // the list is walked by links, so they are decoded without checking for null_link on every step
+    for (auto current_link = block_header_policy::to_link(_trusted_memory, *get_first_available_block_address_address()); current_link != block_header_policy::null_link; )
+    {
+        auto *const current_block = block_header_policy::get_linked_block_address(_trusted_memory, current_link);
+        auto const current_block_size = get_block_size(current_block);
+        current_link = get_available_block_links(current_block)[1];
+
+        if (current_block_size >= block_size && (target_block == nullptr || fit_policy::is_better(current_block_size, target_block_size)))
+        {
+            target_block = current_block;
+            target_block_size = current_block_size;
+
+            if constexpr (fit_policy::stops_at_first_fitting_block)
+            {
+                break;
+            }
+
+            if constexpr (fit_policy::stops_at_exactly_fitting_block)
+            {
+                if (current_block_size == block_size)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    return target_block;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!allocator_fit_allocation::is_block_size_supported(requested_block_size, alignment))
+    {
+        log_policy::log([] { return std::string("no memory available to allocate"); }, logger::severity::warning);
+
+        return nullptr;
+    }
+
+    std::unique_lock<lock_policy> lock(*get_lock());
+
+    auto block_size = get_overridden_block_size(requested_block_size);
+
+    // space skipped to align the block is left available, so it should fit an available block
+    auto const alignment_padding_size = alignment > block_alignment
+        ? alignment + available_block_service_block_size
+        : 0;
+
+    auto *target_block = find_available_block(block_size + alignment_padding_size);
+
+    if (target_block == nullptr)
+    {
+        lock.unlock();
+        log_policy::log([] { return std::string("no memory available to allocate"); }, logger::severity::warning);
+
+        return nullptr;
+    }
+
+    auto target_block_size = get_block_size(target_block);
+    remove_available_block(target_block);
+
+    auto const aligned_block_offset = alignment > block_alignment
+        ? get_aligned_block_offset(target_block, alignment)
+        : 0;
+
+    if (aligned_block_offset != 0)
+    {
+        insert_available_block(target_block, aligned_block_offset);
+        target_block = reinterpret_cast<unsigned char *>(target_block) + aligned_block_offset;
+        target_block_size -= aligned_block_offset;
+    }
+
+    if (target_block_size - block_size < split_block_size_threshold)
+    {
+        block_size = target_block_size;
+    }
+    else
+    {
+        insert_available_block(reinterpret_cast<unsigned char *>(target_block) + block_size, target_block_size - block_size);
+    }
+
+    set_block_boundary_tags(target_block, block_size, true);
+    lock.unlock();
+
+    auto *const allocated_block = reinterpret_cast<unsigned char *>(target_block) + occupied_block_header_size;
+
+    log_policy::log([&] { return "Allocated block of " + std::to_string(block_size) + " bytes placed at " + address_to_hex(allocated_block); }, logger::severity::trace);
+
+    return allocated_block;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+bool basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::resize_block(
+    void *block_address,
+    size_t new_block_size) noexcept
+{
+    auto const new_block_size_overridden = get_overridden_block_size(new_block_size);
+
+    auto const block_size = get_block_size(block_address);
+    auto *const next_block = reinterpret_cast<unsigned char *>(block_address) + block_size;
+    auto const next_block_size = get_block_occupancy(next_block)
+        ? 0
+        : get_block_size(next_block);
+
+    if (new_block_size_overridden > block_size + next_block_size)
+    {
+        return false;
+    }
+
+    auto const remaining_block_size = block_size + next_block_size - new_block_size_overridden;
+
+    // tail too small to be split off stays inside of the shrunk block
+    if (remaining_block_size < split_block_size_threshold && new_block_size_overridden <= block_size)
+    {
+        return true;
+    }
+
+    if (next_block_size != 0)
+    {
+        remove_available_block(next_block);
+    }
+
+    if (remaining_block_size < split_block_size_threshold)
+    {
+        set_block_boundary_tags(block_address, block_size + next_block_size, true);
+    }
+    else
+    {
+        set_block_boundary_tags(block_address, new_block_size_overridden, true);
+        insert_available_block(reinterpret_cast<unsigned char *>(block_address) + new_block_size_overridden, remaining_block_size);
+    }
+
+    return true;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::reallocate_block(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    if (!allocator_fit_allocation::is_block_size_supported(new_block_size, block_alignment))
+    {
+        log_policy::log([] { return std::string("no memory available to allocate"); }, logger::severity::warning);
+
+        return nullptr;
+    }
+
+    auto *const block_address = reinterpret_cast<unsigned char *>(block_to_reallocate_address) - occupied_block_header_size;
+
+    std::unique_lock<lock_policy> lock(*get_lock());
+
+    if (resize_block(block_address, new_block_size))
+    {
+        return block_to_reallocate_address;
+    }
+
+    auto const data_to_move_size = get_block_size(block_address) - occupied_block_service_block_size;
+    lock.unlock();
+
+    auto *const new_block = allocate_block(new_block_size, block_alignment);
+
+    if (new_block != nullptr)
+    {
+        memcpy(new_block, block_to_reallocate_address, std::min(data_to_move_size, new_block_size));
+        deallocate(block_to_reallocate_address);
+    }
+
+    return new_block;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::allocate(
+    size_t requested_block_size)
+{
+    auto *const allocated_block = allocate_block(requested_block_size, block_alignment);
+
+    if (allocated_block == nullptr)
+    {
+        throw allocator::memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::deallocate(
+    void *block_to_deallocate_address)
+{
+    log_policy::log([&] { return "Deallocating block placed at " + address_to_hex(block_to_deallocate_address); }, logger::severity::trace);
+
+    std::lock_guard<lock_policy> lock(*get_lock());
+
+    auto *block_to_deallocate = reinterpret_cast<unsigned char *>(block_to_deallocate_address) - occupied_block_header_size;
+    auto block_to_deallocate_size = get_block_size(block_to_deallocate);
+    size_t const previous_block_footer = *(reinterpret_cast<boundary_tag_type *>(block_to_deallocate) - 1);
+    auto *const next_block = block_to_deallocate + block_to_deallocate_size;
+
+    if ((previous_block_footer & block_occupancy_flag) == 0)
+    {
+        block_to_deallocate -= previous_block_footer;
+        block_to_deallocate_size += previous_block_footer;
+        remove_available_block(block_to_deallocate);
+    }
+
+    if (!get_block_occupancy(next_block))
+    {
+        block_to_deallocate_size += get_block_size(next_block);
+        remove_available_block(next_block);
+    }
+
+    insert_available_block(block_to_deallocate, block_to_deallocate_size);
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    auto *const reallocated_block = reallocate_block(block_to_reallocate_address, new_block_size);
+
+    if (reallocated_block == nullptr)
+    {
+        throw allocator::memory_exception("no memory available to allocate");
+    }
+
+    return reallocated_block;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        log_policy::log([] { return std::string("alignment should be a power of 2"); }, logger::severity::warning);
+
+        throw allocator::memory_exception("alignment should be a power of 2");
+    }
+
+    auto *const allocated_block = allocate_block(requested_block_size, alignment);
+
+    if (allocated_block == nullptr)
+    {
+        throw allocator::memory_exception("no memory available to allocate");
+    }
+
+    return allocated_block;
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    try
+    {
+        return allocate_block(requested_block_size, block_alignment);
+    }
+    catch (...)
+    {
+        // building a message to log may throw
+        return nullptr;
+    }
+}
+
+template<
+    typename fit_policy,
+    typename lock_policy,
+    typename log_policy,
+    typename backing_policy,
+    typename block_header_policy>
+void *basic_fit_allocator<fit_policy, lock_policy, log_policy, backing_policy, block_header_policy>::try_reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    try
+    {
+        return reallocate_block(block_to_reallocate_address, new_block_size);
+    }
+    catch (...)
+    {
+        // building a message to log may throw
+        return nullptr;
+    }
+}
+
+template<
+    typename basic_fit_allocator_type>
+fit_allocator_adapter<basic_fit_allocator_type>::fit_allocator_adapter(
+    size_t memory_size,
+    allocator *outer_allocator,
+    logger *log):
+    _allocator(memory_size, outer_allocator, log)
+{
+
+}
+
+template<
+    typename basic_fit_allocator_type>
+void *fit_allocator_adapter<basic_fit_allocator_type>::allocate(
+    size_t requested_block_size)
+{
+    return _allocator.allocate(requested_block_size);
+}
+
+template<
+    typename basic_fit_allocator_type>
+void fit_allocator_adapter<basic_fit_allocator_type>::deallocate(
+    void *block_to_deallocate_address)
+{
+    _allocator.deallocate(block_to_deallocate_address);
+}
+
+template<
+    typename basic_fit_allocator_type>
+void *fit_allocator_adapter<basic_fit_allocator_type>::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    return _allocator.reallocate(block_to_reallocate_address, new_block_size);
+}
+
+template<
+    typename basic_fit_allocator_type>
+bool fit_allocator_adapter<basic_fit_allocator_type>::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    auto *const reallocated_block = _allocator.try_reallocate(*block_to_reallocate_address_address, new_block_size);
+
+    if (reallocated_block == nullptr)
+    {
+        return false;
+    }
+
+    *block_to_reallocate_address_address = reallocated_block;
+    return true;
+}
+
+template<
+    typename basic_fit_allocator_type>
+void *fit_allocator_adapter<basic_fit_allocator_type>::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    return _allocator.allocate_aligned(requested_block_size, alignment);
+}
+
+template<
+    typename basic_fit_allocator_type>
+void *fit_allocator_adapter<basic_fit_allocator_type>::try_allocate(
+    size_t requested_block_size) noexcept
+{
+    return _allocator.try_allocate(requested_block_size);
+}
+
+template<
+    typename basic_fit_allocator_type>
+void *fit_allocator_adapter<basic_fit_allocator_type>::try_reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size) noexcept
+{
+    return _allocator.try_reallocate(block_to_reallocate_address, new_block_size);
+}
+
+#endif // DATA_STRUCTURES_CPP_BASIC_FIT_ALLOCATOR_H
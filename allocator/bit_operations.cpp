@@ -0,0 +1,29 @@
+#include "bit_operations.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+size_t bit_operations::find_first_set(
+    size_t value) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return index;
+#else
+    return static_cast<size_t>(__builtin_ctzll(value));
+#endif
+}
+
+size_t bit_operations::find_last_set(
+    size_t value) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return index;
+#else
+    return sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(value));
+#endif
+}
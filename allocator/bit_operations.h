@@ -0,0 +1,25 @@
+#ifndef DATA_STRUCTURES_CPP_BIT_OPERATIONS_H
+#define DATA_STRUCTURES_CPP_BIT_OPERATIONS_H
+
+#include <cstddef>
+
+class bit_operations final
+{
+
+public:
+
+    bit_operations() = delete;
+
+public:
+
+    // index of the lowest set bit; value must be non-zero
+    [[nodiscard]] static size_t find_first_set(
+        size_t value) noexcept;
+
+    // index of the highest set bit; value must be non-zero
+    [[nodiscard]] static size_t find_last_set(
+        size_t value) noexcept;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_BIT_OPERATIONS_H
@@ -28,6 +28,10 @@ public:
         std::string const &message,
         logger::severity severity) const noexcept = 0;
 
+    // lets callers skip building messages nobody would get
+    [[nodiscard]] virtual bool is_enabled(
+        logger::severity severity) const noexcept;
+
 public:
 
     logger const *trace(
@@ -76,4 +76,18 @@ logger const *logger_concrete::log(
     }
 
     return this;
+}
+
+bool logger_concrete::is_enabled(
+    logger::severity severity) const noexcept
+{
+    for (auto & logger_stream : _logger_streams)
+    {
+        if (logger_stream.second.second <= severity)
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
\ No newline at end of file
@@ -40,6 +40,9 @@ public:
         const std::string &message,
         logger::severity severity) const noexcept override;
 
+    [[nodiscard]] bool is_enabled(
+        logger::severity severity) const noexcept override;
+
 };
 
 #endif // DATA_STRUCTURES_CPP_LOGGER_CONCRETE_H
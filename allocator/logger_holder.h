@@ -1,8 +1,11 @@
 #ifndef DATA_STRUCTURES_CPP_LOGGER_HOLDER_H
 #define DATA_STRUCTURES_CPP_LOGGER_HOLDER_H
 
+#include <type_traits>
 #include "logger.h"
 
+// message may be passed built, as a string literal, which is converted only when logged, or as a callable
+// returning it, which is called only when logged; defining LOGGER_HOLDER_DISABLE_LOGGING compiles logging out
 class logger_holder
 {
 
@@ -12,27 +15,44 @@ public:
 
 public:
 
+    [[nodiscard]] bool is_enabled_with_guard(
+        logger::severity severity) const noexcept;
+
+    template<
+        typename message_type>
     logger_holder const *log_with_guard(
-        std::string const &message,
+        message_type const &message,
         logger::severity severity) const;
 
+    template<
+        typename message_type>
     logger_holder const *trace_with_guard(
-        std::string const &message) const;
+        message_type const &message) const;
 
+    template<
+        typename message_type>
     logger_holder const *debug_with_guard(
-        std::string const &message) const;
+        message_type const &message) const;
 
+    template<
+        typename message_type>
     logger_holder const *information_with_guard(
-        std::string const &message) const;
+        message_type const &message) const;
 
+    template<
+        typename message_type>
     logger_holder const *warning_with_guard(
-        std::string const &message) const;
+        message_type const &message) const;
 
+    template<
+        typename message_type>
     logger_holder const *error_with_guard(
-        std::string const &message) const;
+        message_type const &message) const;
 
+    template<
+        typename message_type>
     logger_holder const *critical_with_guard(
-        std::string const &message) const;
+        message_type const &message) const;
 
 protected:
 
@@ -40,4 +60,77 @@ protected:
 
 };
 
+template<
+    typename message_type>
+logger_holder const *logger_holder::log_with_guard(
+    [[maybe_unused]] message_type const &message,
+    [[maybe_unused]] logger::severity severity) const
+{
+#ifndef LOGGER_HOLDER_DISABLE_LOGGING
+    auto *got_logger = get_logger();
+
+    if (got_logger != nullptr && got_logger->is_enabled(severity))
+    {
+        if constexpr (std::is_invocable_v<message_type const &>)
+        {
+            got_logger->log(message(), severity);
+        }
+        else
+        {
+            got_logger->log(message, severity);
+        }
+    }
+#endif
+
+    return this;
+}
+
+template<
+    typename message_type>
+logger_holder const *logger_holder::trace_with_guard(
+    message_type const &message) const
+{
+    return log_with_guard(message, logger::severity::trace);
+}
+
+template<
+    typename message_type>
+logger_holder const *logger_holder::debug_with_guard(
+    message_type const &message) const
+{
+    return log_with_guard(message, logger::severity::debug);
+}
+
+template<
+    typename message_type>
+logger_holder const *logger_holder::information_with_guard(
+    message_type const &message) const
+{
+    return log_with_guard(message, logger::severity::information);
+}
+
+template<
+    typename message_type>
+logger_holder const *logger_holder::warning_with_guard(
+    message_type const &message) const
+{
+    return log_with_guard(message, logger::severity::warning);
+}
+
+template<
+    typename message_type>
+logger_holder const *logger_holder::error_with_guard(
+    message_type const &message) const
+{
+    return log_with_guard(message, logger::severity::error);
+}
+
+template<
+    typename message_type>
+logger_holder const *logger_holder::critical_with_guard(
+    message_type const &message) const
+{
+    return log_with_guard(message, logger::severity::critical);
+}
+
 #endif // DATA_STRUCTURES_CPP_LOGGER_HOLDER_H
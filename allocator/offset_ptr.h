@@ -0,0 +1,184 @@
+#ifndef DATA_STRUCTURES_CPP_OFFSET_PTR_H
+#define DATA_STRUCTURES_CPP_OFFSET_PTR_H
+
+#include <cstddef>
+#include <cstdint>
+
+// pointer keeping the distance from itself to the pointee, so structures built of them stay valid wherever the
+// memory holding both is mapped; offset 1 can't address anything properly aligned and stands for null
+template<
+    typename T>
+class offset_ptr final
+{
+
+private:
+
+    static constexpr std::ptrdiff_t null_offset = 1;
+
+private:
+
+    std::ptrdiff_t _offset;
+
+public:
+
+    offset_ptr() noexcept;
+
+    offset_ptr(
+        std::nullptr_t) noexcept;
+
+    offset_ptr(
+        T *pointer) noexcept;
+
+    offset_ptr(
+        offset_ptr const &other) noexcept;
+
+    offset_ptr &operator=(
+        offset_ptr const &other) noexcept;
+
+    offset_ptr &operator=(
+        T *pointer) noexcept;
+
+public:
+
+    [[nodiscard]] T *get() const noexcept;
+
+    T &operator*() const noexcept;
+
+    T *operator->() const noexcept;
+
+    T &operator[](
+        std::ptrdiff_t index) const noexcept;
+
+    explicit operator bool() const noexcept;
+
+    bool operator==(
+        offset_ptr const &other) const noexcept;
+
+    bool operator!=(
+        offset_ptr const &other) const noexcept;
+
+private:
+
+    void set(
+        T *pointer) noexcept;
+
+};
+
+template<
+    typename T>
+offset_ptr<T>::offset_ptr() noexcept:
+    _offset(null_offset)
+{
+
+}
+
+template<
+    typename T>
+offset_ptr<T>::offset_ptr(
+    std::nullptr_t) noexcept:
+    _offset(null_offset)
+{
+
+}
+
+template<
+    typename T>
+offset_ptr<T>::offset_ptr(
+    T *pointer) noexcept
+{
+    set(pointer);
+}
+
+template<
+    typename T>
+offset_ptr<T>::offset_ptr(
+    offset_ptr const &other) noexcept
+{
+    set(other.get());
+}
+
+template<
+    typename T>
+offset_ptr<T> &offset_ptr<T>::operator=(
+    offset_ptr const &other) noexcept
+{
+    set(other.get());
+
+    return *this;
+}
+
+template<
+    typename T>
+offset_ptr<T> &offset_ptr<T>::operator=(
+    T *pointer) noexcept
+{
+    set(pointer);
+
+    return *this;
+}
+
+template<
+    typename T>
+T *offset_ptr<T>::get() const noexcept
+{
+    return _offset == null_offset
+        ? nullptr
+        : reinterpret_cast<T *>(reinterpret_cast<std::uintptr_t>(this) + _offset);
+}
+
+template<
+    typename T>
+T &offset_ptr<T>::operator*() const noexcept
+{
+    return *get();
+}
+
+template<
+    typename T>
+T *offset_ptr<T>::operator->() const noexcept
+{
+    return get();
+}
+
+template<
+    typename T>
+T &offset_ptr<T>::operator[](
+    std::ptrdiff_t index) const noexcept
+{
+    return get()[index];
+}
+
+template<
+    typename T>
+offset_ptr<T>::operator bool() const noexcept
+{
+    return _offset != null_offset;
+}
+
+template<
+    typename T>
+bool offset_ptr<T>::operator==(
+    offset_ptr const &other) const noexcept
+{
+    return get() == other.get();
+}
+
+template<
+    typename T>
+bool offset_ptr<T>::operator!=(
+    offset_ptr const &other) const noexcept
+{
+    return get() != other.get();
+}
+
+template<
+    typename T>
+void offset_ptr<T>::set(
+    T *pointer) noexcept
+{
+    _offset = pointer == nullptr
+        ? null_offset
+        : static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(pointer) - reinterpret_cast<std::uintptr_t>(this));
+}
+
+#endif // DATA_STRUCTURES_CPP_OFFSET_PTR_H
@@ -0,0 +1,101 @@
+#ifndef DATA_STRUCTURES_CPP_MEMORY_WITH_POOL_TYPED_H
+#define DATA_STRUCTURES_CPP_MEMORY_WITH_POOL_TYPED_H
+
+#include <new>
+#include <utility>
+#include "allocator_pool.h"
+
+template<
+    typename T>
+class pool final
+{
+
+    // pool blocks are aligned to the largest power of 2 dividing their size, capped by the pool
+    static_assert(alignof(T) <= allocator_pool::get_block_alignment(sizeof(T)), "pool<T> blocks can't satisfy alignment of T");
+
+private:
+
+    allocator_pool _allocator;
+
+public:
+
+    explicit pool(
+        size_t objects_per_slab_count,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr);
+
+    pool(
+        pool const &other) = delete;
+
+    pool &operator=(
+        pool const &other) = delete;
+
+public:
+
+    template<
+        typename ...Args>
+    [[nodiscard]] T *construct(
+        Args &&...args);
+
+    void destroy(
+        T *object);
+
+public:
+
+    [[nodiscard]] allocator *get_allocator() noexcept;
+
+};
+
+template<
+    typename T>
+pool<T>::pool(
+    size_t objects_per_slab_count,
+    allocator *outer_allocator,
+    logger *logger):
+    _allocator(sizeof(T), objects_per_slab_count, outer_allocator, logger)
+{
+
+}
+
+template<
+    typename T>
+template<
+    typename ...Args>
+T *pool<T>::construct(
+    Args &&...args)
+{
+    auto *block = _allocator.allocate(sizeof(T));
+
+    try
+    {
+        return new (block) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        _allocator.deallocate(block);
+        throw;
+    }
+}
+
+template<
+    typename T>
+void pool<T>::destroy(
+    T *object)
+{
+    if (object == nullptr)
+    {
+        return;
+    }
+
+    object->~T();
+    _allocator.deallocate(object);
+}
+
+template<
+    typename T>
+allocator *pool<T>::get_allocator() noexcept
+{
+    return &_allocator;
+}
+
+#endif // DATA_STRUCTURES_CPP_MEMORY_WITH_POOL_TYPED_H
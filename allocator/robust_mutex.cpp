@@ -0,0 +1,117 @@
+#include <cerrno>
+#include <system_error>
+#include "robust_mutex.h"
+
+robust_mutex::recovering_lock::recovering_lock(
+    robust_mutex &mutex,
+    recoverer &owner_died_recoverer) noexcept:
+    _mutex(&mutex),
+    _recoverer(&owner_died_recoverer)
+{
+
+}
+
+void robust_mutex::recovering_lock::lock()
+{
+    _mutex->lock(*_recoverer);
+}
+
+bool robust_mutex::recovering_lock::try_lock()
+{
+    return _mutex->try_lock(*_recoverer);
+}
+
+void robust_mutex::recovering_lock::unlock() noexcept
+{
+    _mutex->unlock();
+}
+
+robust_mutex::robust_mutex()
+{
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+
+    auto const result = pthread_mutex_init(&_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+
+    if (result != 0)
+    {
+        throw std::system_error(result, std::generic_category(), "can't initialize robust mutex");
+    }
+}
+
+robust_mutex::~robust_mutex() noexcept
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+void robust_mutex::lock()
+{
+    (void)take_over(pthread_mutex_lock(&_mutex), nullptr);
+}
+
+bool robust_mutex::try_lock()
+{
+    return take_over(pthread_mutex_trylock(&_mutex), nullptr);
+}
+
+void robust_mutex::lock(
+    recoverer &owner_died_recoverer)
+{
+    (void)take_over(pthread_mutex_lock(&_mutex), &owner_died_recoverer);
+}
+
+bool robust_mutex::try_lock(
+    recoverer &owner_died_recoverer)
+{
+    return take_over(pthread_mutex_trylock(&_mutex), &owner_died_recoverer);
+}
+
+void robust_mutex::unlock() noexcept
+{
+    pthread_mutex_unlock(&_mutex);
+}
+
+bool robust_mutex::take_over(
+    int result,
+    recoverer *owner_died_recoverer)
+{
+    switch (result)
+    {
+        case 0:
+            return true;
+        case EBUSY:
+            return false;
+        case EOWNERDEAD:
+            break;
+        default:
+            // ENOTRECOVERABLE once a previous take over failed
+            throw std::system_error(result, std::generic_category(), "can't lock robust mutex");
+    }
+
+    // guarded data is only trusted again after it is restored; unlocked without being marked consistent, the mutex
+    // turns unrecoverable for every process
+    if (owner_died_recoverer == nullptr)
+    {
+        pthread_mutex_unlock(&_mutex);
+
+        throw std::system_error(EOWNERDEAD, std::generic_category(), "robust mutex owner died, guarded data can't be restored");
+    }
+
+    try
+    {
+        owner_died_recoverer->recover();
+    }
+    catch (...)
+    {
+        pthread_mutex_unlock(&_mutex);
+
+        throw;
+    }
+
+    pthread_mutex_consistent(&_mutex);
+
+    return true;
+}
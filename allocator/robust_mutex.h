@@ -0,0 +1,97 @@
+#ifndef DATA_STRUCTURES_CPP_ROBUST_MUTEX_H
+#define DATA_STRUCTURES_CPP_ROBUST_MUTEX_H
+
+#include <cstddef>
+#include <pthread.h>
+
+// process-shared mutex to be placed in memory mapped by several processes; when its owner dies, the next locker
+// takes it over instead of waiting forever. Satisfies Lockable, so it works with std::lock_guard
+class alignas(sizeof(size_t)) robust_mutex final
+{
+
+public:
+
+    // restores data guarded by the mutex whose owner died inside its critical section; throws if the data can't be
+    // restored
+    class recoverer
+    {
+
+    public:
+
+        virtual ~recoverer() noexcept = default;
+
+    public:
+
+        virtual void recover() = 0;
+
+    };
+
+    // the mutex lives in shared memory, while recoverer is an object of the locking process; this process-local
+    // Lockable pairs them, so that the mutex works with std::lock_guard
+    class recovering_lock final
+    {
+
+    private:
+
+        robust_mutex *_mutex;
+
+        recoverer *_recoverer;
+
+    public:
+
+        recovering_lock(
+            robust_mutex &mutex,
+            recoverer &owner_died_recoverer) noexcept;
+
+    public:
+
+        void lock();
+
+        [[nodiscard]] bool try_lock();
+
+        void unlock() noexcept;
+
+    };
+
+private:
+
+    pthread_mutex_t _mutex;
+
+public:
+
+    robust_mutex();
+
+    robust_mutex(
+        robust_mutex const &other) = delete;
+
+    robust_mutex &operator=(
+        robust_mutex const &other) = delete;
+
+    ~robust_mutex() noexcept;
+
+public:
+
+    // without a recoverer the data left by a dead owner can't be trusted, so the lock throws and the mutex stays
+    // unrecoverable for every process
+    void lock();
+
+    [[nodiscard]] bool try_lock();
+
+    void lock(
+        recoverer &owner_died_recoverer);
+
+    [[nodiscard]] bool try_lock(
+        recoverer &owner_died_recoverer);
+
+    void unlock() noexcept;
+
+private:
+
+    // returns whether the mutex is taken by the call that finished with the result
+    [[nodiscard]] bool take_over(
+        int result,
+        recoverer *owner_died_recoverer);
+
+};
+
+#endif // DATA_STRUCTURES_CPP_ROBUST_MUTEX_H
@@ -0,0 +1,352 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include "sharded_allocator.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace
+{
+
+    std::atomic<size_t> next_thread_shard_index(0);
+
+}
+
+sharded_allocator::sharded_allocator(
+    size_t shards_count,
+    size_t shard_memory_size,
+    sharded_allocator::shard_factory factory,
+    allocator *outer_allocator,
+    logger *log)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested shards count: " + std::to_string(shards_count) + ", shard memory size: " + std::to_string(shard_memory_size) + " bytes");
+    }
+
+    if (shards_count == 0 || factory == nullptr)
+    {
+        auto error_message = "shards count should be GT 0 and shard factory should be provided";
+
+        if (log != nullptr)
+        {
+            log->error(error_message);
+        }
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    auto const allocator_service_block_size = shards_offset + shards_count * shard_service_block_size;
+
+    _trusted_memory = outer_allocator == nullptr
+        ? ::operator new(allocator_service_block_size, std::align_val_t(cache_line_size))
+        : outer_allocator->allocate_aligned(allocator_service_block_size, cache_line_size);
+
+    auto * const shards_count_space = reinterpret_cast<size_t *>(_trusted_memory);
+    *shards_count_space = shards_count;
+
+    auto * const outer_allocator_pointer_space = reinterpret_cast<allocator **>(shards_count_space + 1);
+    *outer_allocator_pointer_space = outer_allocator;
+
+    auto * const logger_pointer_space = reinterpret_cast<logger **>(outer_allocator_pointer_space + 1);
+    *logger_pointer_space = log;
+
+    for (size_t i = 0; i < shards_count; i++)
+    {
+        auto * const shard = get_shard_address(i);
+        *reinterpret_cast<allocator **>(shard) = nullptr;
+        new (reinterpret_cast<allocator **>(shard) + 1) std::atomic<void *>(nullptr);
+    }
+
+    try
+    {
+        for (size_t i = 0; i < shards_count; i++)
+        {
+            *reinterpret_cast<allocator **>(get_shard_address(i)) = factory(shard_memory_size, outer_allocator, log);
+        }
+    }
+    catch (...)
+    {
+        for (size_t i = 0; i < shards_count; i++)
+        {
+            delete get_shard_allocator(i);
+        }
+
+        deallocate_aligned_with_guard(_trusted_memory, cache_line_size);
+
+        throw;
+    }
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+sharded_allocator::~sharded_allocator() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+
+    for (size_t i = 0, shards_count = get_shards_count(); i < shards_count; i++)
+    {
+        release_remote_released_blocks(i);
+        delete get_shard_allocator(i);
+    }
+
+    deallocate_aligned_with_guard(_trusted_memory, cache_line_size);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t sharded_allocator::get_allocator_service_block_size() const noexcept
+{
+    return shards_offset + get_shards_count() * shard_service_block_size;
+}
+
+size_t sharded_allocator::get_occupied_block_service_block_size() const noexcept
+{
+    auto const shard_index_size = sizeof(size_t);
+    auto const block_size_size = sizeof(size_t);
+
+    return shard_index_size + block_size_size;
+}
+
+size_t sharded_allocator::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *(reinterpret_cast<size_t const *>(current_block_address) + 1);
+}
+
+size_t sharded_allocator::get_shards_count() const noexcept
+{
+    return *reinterpret_cast<size_t *>(_trusted_memory);
+}
+
+unsigned char *sharded_allocator::get_shard_address(
+    size_t shard_index) const noexcept
+{
+    return reinterpret_cast<unsigned char *>(_trusted_memory) + shards_offset + shard_index * shard_service_block_size;
+}
+
+allocator *sharded_allocator::get_shard_allocator(
+    size_t shard_index) const noexcept
+{
+    return *reinterpret_cast<allocator **>(get_shard_address(shard_index));
+}
+
+size_t sharded_allocator::get_current_shard_index() const noexcept
+{
+#if defined(__linux__)
+    auto const cpu = sched_getcpu();
+
+    if (cpu >= 0)
+    {
+        return static_cast<size_t>(cpu) % get_shards_count();
+    }
+#endif
+
+    thread_local size_t const thread_shard_index = next_thread_shard_index.fetch_add(1, std::memory_order_relaxed);
+
+    return thread_shard_index % get_shards_count();
+}
+
+void sharded_allocator::push_remote_released_block(
+    size_t shard_index,
+    void *block_address) noexcept
+{
+    auto &remote_released_blocks = *reinterpret_cast<std::atomic<void *> *>(reinterpret_cast<allocator **>(get_shard_address(shard_index)) + 1);
+
+    // block size slot keeps the next released block; stack is only ever popped as a whole, so there is no ABA
+    auto * const next_block_address_space = reinterpret_cast<void **>(reinterpret_cast<size_t *>(block_address) + 1);
+    *next_block_address_space = remote_released_blocks.load(std::memory_order_relaxed);
+
+    while (!remote_released_blocks.compare_exchange_weak(*next_block_address_space, block_address, std::memory_order_release, std::memory_order_relaxed))
+    {
+
+    }
+}
+
+void sharded_allocator::release_remote_released_blocks(
+    size_t shard_index)
+{
+    auto &remote_released_blocks = *reinterpret_cast<std::atomic<void *> *>(reinterpret_cast<allocator **>(get_shard_address(shard_index)) + 1);
+
+    if (remote_released_blocks.load(std::memory_order_relaxed) == nullptr)
+    {
+        return;
+    }
+
+    auto *block = remote_released_blocks.exchange(nullptr, std::memory_order_acquire);
+    auto * const shard_allocator = get_shard_allocator(shard_index);
+
+    while (block != nullptr)
+    {
+        auto * const next_block = *reinterpret_cast<void **>(reinterpret_cast<size_t *>(block) + 1);
+        shard_allocator->deallocate(block);
+        block = next_block;
+    }
+}
+
+void *sharded_allocator::allocate_block(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    auto const occupied_block_service_block_size = get_occupied_block_service_block_size();
+    auto const block_data_offset = std::max(occupied_block_service_block_size, alignment);
+    auto const shards_count = get_shards_count();
+    auto const current_shard_index = get_current_shard_index();
+
+    // exhausted shard of current cpu falls back to the next ones
+    for (size_t i = 0; i < shards_count; i++)
+    {
+        auto const shard_index = (current_shard_index + i) % shards_count;
+        release_remote_released_blocks(shard_index);
+
+        unsigned char *shard_block;
+
+        try
+        {
+            // shard aligns the block itself, the header is placed right before aligned data
+            shard_block = alignment > sizeof(size_t)
+                ? reinterpret_cast<unsigned char *>(get_shard_allocator(shard_index)->allocate_aligned(block_data_offset + requested_block_size, alignment))
+                : reinterpret_cast<unsigned char *>(get_shard_allocator(shard_index)->allocate(block_data_offset + requested_block_size));
+        }
+        catch (memory_exception const &)
+        {
+            continue;
+        }
+
+        auto const block_offset = block_data_offset - occupied_block_service_block_size;
+        auto * const block = reinterpret_cast<size_t *>(shard_block + block_offset);
+        *block = shard_index | (block_offset << block_offset_shift);
+        *(block + 1) = requested_block_size;
+
+        this->trace_with_guard([&] { return "Allocated block placed at " + address_to_hex(block) + " in shard #" + std::to_string(shard_index); });
+
+        return block + 2;
+    }
+
+    auto const warning_message = "no memory available to allocate";
+
+    this->warning_with_guard(warning_message);
+
+    throw memory_exception(warning_message);
+}
+
+void *sharded_allocator::allocate(
+    size_t requested_block_size)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory"; });
+
+    auto * const allocated_block = allocate_block(requested_block_size, sizeof(size_t));
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate(size_t requested_block_size)` execution finished"; });
+
+    return allocated_block;
+}
+
+void sharded_allocator::deallocate(
+    void *block_to_deallocate_address)
+{
+    this->trace_with_guard([&] { return get_typename() + "::deallocate(void *block_to_deallocate_address) execution started"; });
+
+    auto * const block = reinterpret_cast<size_t *>(block_to_deallocate_address) - 2;
+    auto const shard_index = *block & ((static_cast<size_t>(1) << block_offset_shift) - 1);
+    auto * const shard_block = reinterpret_cast<unsigned char *>(block) - (*block >> block_offset_shift);
+
+    if (shard_index == get_current_shard_index())
+    {
+        get_shard_allocator(shard_index)->deallocate(shard_block);
+    }
+    else
+    {
+        push_remote_released_block(shard_index, shard_block);
+    }
+
+    this->trace_with_guard([&] { return get_typename() + "::deallocate method execution finished"; });
+}
+
+void *sharded_allocator::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    auto * const block = reinterpret_cast<size_t *>(block_to_reallocate_address) - 2;
+    auto const block_size = get_occupied_block_size(block);
+
+    if (new_block_size <= block_size)
+    {
+        *(block + 1) = new_block_size;
+
+        return block_to_reallocate_address;
+    }
+
+    auto * const new_block = allocate(new_block_size);
+    memcpy(new_block, block_to_reallocate_address, block_size);
+    deallocate(block_to_reallocate_address);
+
+    return new_block;
+}
+
+void *sharded_allocator::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution started"; })
+        ->debug_with_guard([&] { return "Requested " + std::to_string(requested_block_size) + " bytes of memory aligned to " + std::to_string(alignment) + " bytes"; });
+
+    if (!is_alignment_valid(alignment))
+    {
+        auto const warning_message = "alignment should be a power of 2";
+
+        this->warning_with_guard(warning_message)
+            ->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+        throw memory_exception(warning_message);
+    }
+
+    auto * const allocated_block = allocate_block(requested_block_size, alignment);
+
+    this->trace_with_guard([&] { return "Method `void *" + get_typename() + "::allocate_aligned(size_t requested_block_size, size_t alignment)` execution finished"; });
+
+    return allocated_block;
+}
+
+bool sharded_allocator::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    try {
+        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
+        return true;
+    }
+    catch (std::exception const &ex)
+    {
+        this->warning_with_guard(ex.what());
+        return false;
+    }
+}
+
+logger *sharded_allocator::get_logger() const noexcept
+{
+    return *reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1);
+}
+
+std::string sharded_allocator::get_typename() const noexcept
+{
+    return "sharded_allocator";
+}
+
+allocator *sharded_allocator::get_allocator() const noexcept
+{
+    return *reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1);
+}
@@ -0,0 +1,149 @@
+#ifndef DATA_STRUCTURES_CPP_SHARDED_ALLOCATOR_H
+#define DATA_STRUCTURES_CPP_SHARDED_ALLOCATOR_H
+
+#include <atomic>
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "allocator_holder.h"
+
+// owns independent engine instances (shards) and serves every request from the shard of the current cpu;
+// blocks released on a foreign shard are handed back to the owner through a lock-free stack
+class sharded_allocator final:
+    public allocator,
+    protected logger_holder,
+    protected typename_holder,
+    protected allocator_holder
+{
+
+public:
+
+    using shard_factory = allocator *(*)(
+        size_t memory_size,
+        allocator *outer_allocator,
+        logger *logger);
+
+    template<
+        typename engine>
+    static allocator *create_shard(
+        size_t memory_size,
+        allocator *outer_allocator,
+        logger *logger);
+
+private:
+
+    static constexpr size_t cache_line_size = 64;
+
+    // trusted memory is allocated aligned to cache line: [shards count][outer allocator][logger][padding][shards...]
+    static constexpr size_t shards_offset = cache_line_size;
+
+    // every shard service block [shard allocator][remote released blocks stack top] takes the whole cache line, so
+    // remote releases to one shard don't bounce others
+    static constexpr size_t shard_service_block_size = cache_line_size;
+
+    static_assert(sizeof(size_t) + sizeof(allocator *) + sizeof(logger *) <= shards_offset, "service fields should fit before the shards");
+
+    static_assert(sizeof(allocator *) + sizeof(std::atomic<void *>) <= shard_service_block_size, "shard service block should fit cache line");
+
+    // upper half of the shard index slot keeps the offset of aligned block header from the block got from the shard
+    static constexpr size_t block_offset_shift = sizeof(size_t) * 4;
+
+private:
+
+    void *_trusted_memory;
+
+public:
+
+    explicit sharded_allocator(
+        size_t shards_count,
+        size_t shard_memory_size,
+        shard_factory factory,
+        allocator *outer_allocator = nullptr,
+        logger *logger = nullptr);
+
+    sharded_allocator(
+        sharded_allocator const &other) = delete;
+
+    sharded_allocator &operator=(
+        sharded_allocator const &other) = delete;
+
+    ~sharded_allocator() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    size_t get_occupied_block_size(
+        void const *current_block_address) const override;
+
+private:
+
+    [[nodiscard]] size_t get_shards_count() const noexcept;
+
+    [[nodiscard]] unsigned char *get_shard_address(
+        size_t shard_index) const noexcept;
+
+    [[nodiscard]] allocator *get_shard_allocator(
+        size_t shard_index) const noexcept;
+
+    [[nodiscard]] size_t get_current_shard_index() const noexcept;
+
+    void push_remote_released_block(
+        size_t shard_index,
+        void *block_address) noexcept;
+
+    void release_remote_released_blocks(
+        size_t shard_index);
+
+    [[nodiscard]] void *allocate_block(
+        size_t requested_block_size,
+        size_t alignment);
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+private:
+
+    [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+};
+
+template<
+    typename engine>
+allocator *sharded_allocator::create_shard(
+    size_t memory_size,
+    allocator *outer_allocator,
+    logger *logger)
+{
+    return new engine(memory_size, outer_allocator, logger);
+}
+
+#endif // DATA_STRUCTURES_CPP_SHARDED_ALLOCATOR_H
@@ -0,0 +1,58 @@
+#include <thread>
+#include "spinlock.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+spinlock::spinlock() noexcept:
+    _is_locked(false)
+{
+
+}
+
+void spinlock::lock() noexcept
+{
+    size_t backoff_pauses_count = 1;
+
+    while (_is_locked.exchange(true, std::memory_order_acquire))
+    {
+        // spin on a plain load so the cache line stays shared until the owner releases it
+        while (_is_locked.load(std::memory_order_relaxed))
+        {
+            if (backoff_pauses_count > max_backoff_pauses_count)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t i = 0; i < backoff_pauses_count; i++)
+            {
+                pause();
+            }
+
+            backoff_pauses_count <<= 1;
+        }
+    }
+}
+
+bool spinlock::try_lock() noexcept
+{
+    return !_is_locked.load(std::memory_order_relaxed) && !_is_locked.exchange(true, std::memory_order_acquire);
+}
+
+void spinlock::unlock() noexcept
+{
+    _is_locked.store(false, std::memory_order_release);
+}
+
+void spinlock::pause() noexcept
+{
+#if defined(_MSC_VER)
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
@@ -0,0 +1,43 @@
+#ifndef DATA_STRUCTURES_CPP_SPINLOCK_H
+#define DATA_STRUCTURES_CPP_SPINLOCK_H
+
+#include <atomic>
+#include <cstddef>
+
+// test-and-test-and-set lock with exponential backoff; satisfies Lockable, so it works with std::lock_guard
+class alignas(sizeof(size_t)) spinlock final
+{
+
+private:
+
+    static constexpr size_t max_backoff_pauses_count = 1024;
+
+private:
+
+    std::atomic<bool> _is_locked;
+
+public:
+
+    spinlock() noexcept;
+
+    spinlock(
+        spinlock const &other) = delete;
+
+    spinlock &operator=(
+        spinlock const &other) = delete;
+
+public:
+
+    void lock() noexcept;
+
+    [[nodiscard]] bool try_lock() noexcept;
+
+    void unlock() noexcept;
+
+private:
+
+    static void pause() noexcept;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_SPINLOCK_H
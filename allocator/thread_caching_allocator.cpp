@@ -0,0 +1,459 @@
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "thread_caching_allocator.h"
+
+struct thread_caching_allocator::thread_cache_entry
+{
+
+    // 0 when allocator instance is destroyed; entries are never released before thread exit, so
+    // pointers to them stay valid
+    std::atomic<size_t> instance_id;
+
+    allocator *underlying_allocator;
+
+    void *first_blocks[size_classes_count];
+
+    size_t blocks_counts[size_classes_count];
+
+};
+
+struct thread_caching_allocator::thread_cache
+{
+
+    std::vector<std::unique_ptr<thread_cache_entry>> entries;
+
+    thread_cache_entry *last_used_entry = nullptr;
+
+    thread_cache()
+    {
+        std::lock_guard<std::mutex> lock(get_registry_mutex());
+        get_registry().push_back(this);
+    }
+
+    ~thread_cache() noexcept
+    {
+        std::lock_guard<std::mutex> lock(get_registry_mutex());
+
+        auto &registry = get_registry();
+        for (auto iterator = registry.begin(); iterator != registry.end(); ++iterator)
+        {
+            if (*iterator == this)
+            {
+                registry.erase(iterator);
+                break;
+            }
+        }
+
+        // blocks cached by exiting thread are returned to allocators which are still alive
+        for (auto &entry : entries)
+        {
+            if (entry->instance_id.load(std::memory_order_relaxed) == 0)
+            {
+                continue;
+            }
+
+            for (size_t i = 0; i < size_classes_count; i++)
+            {
+                while (entry->first_blocks[i] != nullptr)
+                {
+                    auto *block = entry->first_blocks[i];
+                    entry->first_blocks[i] = *reinterpret_cast<void **>(reinterpret_cast<unsigned char *>(block) + block_header_size);
+
+                    entry->underlying_allocator == nullptr
+                        ? ::operator delete(block)
+                        : entry->underlying_allocator->deallocate(block);
+                }
+            }
+        }
+    }
+
+    static std::mutex &get_registry_mutex()
+    {
+        static std::mutex registry_mutex;
+        return registry_mutex;
+    }
+
+    static std::vector<thread_cache *> &get_registry()
+    {
+        static std::vector<thread_cache *> registry;
+        return registry;
+    }
+
+    static thread_cache &get_current()
+    {
+        thread_local thread_cache current;
+        return current;
+    }
+
+};
+
+namespace
+{
+
+    // instance ids are never reused, so thread caches can't mix up a destroyed instance with a new one placed at the same address
+    std::atomic<size_t> next_instance_id(1);
+
+}
+
+thread_caching_allocator::thread_caching_allocator(
+    allocator *underlying_allocator,
+    logger *log,
+    size_t batch_size)
+{
+    auto got_typename = get_typename();
+
+    if (log != nullptr)
+    {
+        log->trace(got_typename + " allocator instance construction started")
+            ->debug("requested batch size: " + std::to_string(batch_size) + " blocks");
+    }
+
+    if (batch_size == 0)
+    {
+        auto error_message = "batch size should be GT 0";
+
+        if (log != nullptr)
+        {
+            log->error(error_message);
+        }
+
+        throw allocator::memory_exception(error_message);
+    }
+
+    auto const allocator_service_block_size = get_allocator_service_block_size();
+
+    _trusted_memory = underlying_allocator == nullptr
+        ? ::operator new(allocator_service_block_size)
+        : underlying_allocator->allocate(allocator_service_block_size);
+
+    auto * const batch_size_space = reinterpret_cast<size_t *>(_trusted_memory);
+    *batch_size_space = batch_size;
+
+    auto * const underlying_allocator_pointer_space = reinterpret_cast<allocator **>(batch_size_space + 1);
+    *underlying_allocator_pointer_space = underlying_allocator;
+
+    auto * const logger_pointer_space = reinterpret_cast<logger **>(underlying_allocator_pointer_space + 1);
+    *logger_pointer_space = log;
+
+    auto * const instance_id_space = reinterpret_cast<size_t *>(logger_pointer_space + 1);
+    *instance_id_space = next_instance_id.fetch_add(1, std::memory_order_relaxed);
+
+    this->trace_with_guard(got_typename + " allocator instance construction finished");
+}
+
+thread_caching_allocator::~thread_caching_allocator() noexcept
+{
+    auto got_typename = get_typename();
+    this->trace_with_guard(got_typename + " allocator instance destruction started");
+
+    auto const * const logger = get_logger();
+    auto const instance_id = get_instance_id();
+
+    {
+        std::lock_guard<std::mutex> lock(thread_cache::get_registry_mutex());
+
+        for (auto *cache : thread_cache::get_registry())
+        {
+            for (auto &entry : cache->entries)
+            {
+                if (entry->instance_id.load(std::memory_order_relaxed) != instance_id)
+                {
+                    continue;
+                }
+
+                for (size_t i = 0; i < size_classes_count; i++)
+                {
+                    flush(entry.get(), i, entry->blocks_counts[i]);
+                }
+
+                entry->instance_id.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    deallocate_with_guard(_trusted_memory);
+
+    if (logger != nullptr)
+    {
+        logger->trace(got_typename + " allocator instance destruction finished");
+    }
+}
+
+size_t thread_caching_allocator::get_allocator_service_block_size() const noexcept
+{
+    auto const batch_size_size = sizeof(size_t);
+    auto const underlying_allocator_pointer_size = sizeof(allocator *);
+    auto const logger_pointer_size = sizeof(logger *);
+    auto const instance_id_size = sizeof(size_t);
+
+    return batch_size_size + underlying_allocator_pointer_size + logger_pointer_size + instance_id_size;
+}
+
+size_t thread_caching_allocator::get_occupied_block_service_block_size() const noexcept
+{
+    return block_header_size;
+}
+
+size_t thread_caching_allocator::get_occupied_block_size(
+    void const *current_block_address) const
+{
+    return *(reinterpret_cast<size_t const *>(current_block_address) - 1) & ~aligned_block_flag;
+}
+
+size_t thread_caching_allocator::get_batch_size() const noexcept
+{
+    return *reinterpret_cast<size_t *>(_trusted_memory);
+}
+
+size_t thread_caching_allocator::get_instance_id() const noexcept
+{
+    return *reinterpret_cast<size_t *>(reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1) + 1);
+}
+
+size_t thread_caching_allocator::get_size_class_index(
+    size_t block_size) noexcept
+{
+    return block_size == 0
+        ? 0
+        : (block_size - 1) / size_class_granularity;
+}
+
+thread_caching_allocator::thread_cache_entry *thread_caching_allocator::get_thread_cache_entry() const
+{
+    auto &cache = thread_cache::get_current();
+    auto const instance_id = get_instance_id();
+
+    if (cache.last_used_entry != nullptr && cache.last_used_entry->instance_id.load(std::memory_order_relaxed) == instance_id)
+    {
+        return cache.last_used_entry;
+    }
+
+    std::lock_guard<std::mutex> lock(thread_cache::get_registry_mutex());
+
+    thread_cache_entry *released_entry = nullptr;
+
+    for (auto &entry : cache.entries)
+    {
+        auto const entry_instance_id = entry->instance_id.load(std::memory_order_relaxed);
+
+        if (entry_instance_id == instance_id)
+        {
+            return cache.last_used_entry = entry.get();
+        }
+
+        if (entry_instance_id == 0)
+        {
+            released_entry = entry.get();
+        }
+    }
+
+    if (released_entry == nullptr)
+    {
+        cache.entries.push_back(std::make_unique<thread_cache_entry>());
+        released_entry = cache.entries.back().get();
+    }
+
+    released_entry->underlying_allocator = get_allocator();
+    for (size_t i = 0; i < size_classes_count; i++)
+    {
+        released_entry->first_blocks[i] = nullptr;
+        released_entry->blocks_counts[i] = 0;
+    }
+    released_entry->instance_id.store(instance_id, std::memory_order_relaxed);
+
+    return cache.last_used_entry = released_entry;
+}
+
+void thread_caching_allocator::refill(
+    thread_caching_allocator::thread_cache_entry *entry,
+    size_t size_class_index) const
+{
+    auto const batch_size = get_batch_size();
+    auto const block_size = get_occupied_block_service_block_size() + (size_class_index + 1) * size_class_granularity;
+
+    this->debug_with_guard([&] { return "Refilling " + std::to_string(block_size) + " bytes blocks cache with " + std::to_string(batch_size) + " blocks"; });
+
+    for (size_t i = 0; i < batch_size; i++)
+    {
+        void *block;
+
+        try
+        {
+            block = allocate_with_guard(block_size);
+        }
+        catch (std::exception const &)
+        {
+            // partial batch is still useful
+            if (entry->first_blocks[size_class_index] == nullptr)
+            {
+                throw;
+            }
+
+            break;
+        }
+
+        auto * const block_data = reinterpret_cast<unsigned char *>(block) + block_header_size;
+        *(reinterpret_cast<size_t *>(block_data) - 1) = block_size - block_header_size;
+        *reinterpret_cast<void **>(block_data) = entry->first_blocks[size_class_index];
+        entry->first_blocks[size_class_index] = block;
+        ++entry->blocks_counts[size_class_index];
+    }
+}
+
+void thread_caching_allocator::flush(
+    thread_caching_allocator::thread_cache_entry *entry,
+    size_t size_class_index,
+    size_t blocks_count) const
+{
+    this->debug_with_guard([&] { return "Flushing " + std::to_string(blocks_count) + " blocks of " +
+        std::to_string((size_class_index + 1) * size_class_granularity) + " bytes from cache"; });
+
+    for (size_t i = 0; i < blocks_count; i++)
+    {
+        auto *block = entry->first_blocks[size_class_index];
+        entry->first_blocks[size_class_index] = *reinterpret_cast<void **>(reinterpret_cast<unsigned char *>(block) + block_header_size);
+        --entry->blocks_counts[size_class_index];
+
+        deallocate_with_guard(block);
+    }
+}
+
+void *thread_caching_allocator::allocate(
+    size_t requested_block_size)
+{
+    if (requested_block_size > max_cached_block_size)
+    {
+        auto * const block_data = reinterpret_cast<unsigned char *>(allocate_with_guard(block_header_size + requested_block_size)) + block_header_size;
+        *(reinterpret_cast<size_t *>(block_data) - 1) = requested_block_size;
+
+        return block_data;
+    }
+
+    auto const size_class_index = get_size_class_index(requested_block_size);
+    auto * const entry = get_thread_cache_entry();
+
+    if (entry->first_blocks[size_class_index] == nullptr)
+    {
+        refill(entry, size_class_index);
+    }
+
+    auto * const block_data = reinterpret_cast<unsigned char *>(entry->first_blocks[size_class_index]) + block_header_size;
+    entry->first_blocks[size_class_index] = *reinterpret_cast<void **>(block_data);
+    --entry->blocks_counts[size_class_index];
+
+    return block_data;
+}
+
+void thread_caching_allocator::deallocate(
+    void *block_to_deallocate_address)
+{
+    auto * const block_capacity_address = reinterpret_cast<size_t *>(block_to_deallocate_address) - 1;
+    auto const block_capacity = get_occupied_block_size(block_to_deallocate_address);
+
+    // aligned block keeps the address it was allocated at in the word before its capacity
+    if ((*block_capacity_address & aligned_block_flag) != 0)
+    {
+        deallocate_with_guard(*reinterpret_cast<void **>(block_capacity_address - 1));
+
+        return;
+    }
+
+    auto * const block = reinterpret_cast<unsigned char *>(block_to_deallocate_address) - block_header_size;
+
+    if (block_capacity > max_cached_block_size)
+    {
+        deallocate_with_guard(block);
+
+        return;
+    }
+
+    // block allocated on another thread just goes to the cache of this one
+    auto const size_class_index = get_size_class_index(block_capacity);
+    auto * const entry = get_thread_cache_entry();
+
+    *reinterpret_cast<void **>(block_to_deallocate_address) = entry->first_blocks[size_class_index];
+    entry->first_blocks[size_class_index] = block;
+
+    if (++entry->blocks_counts[size_class_index] > 2 * get_batch_size())
+    {
+        flush(entry, size_class_index, get_batch_size());
+    }
+}
+
+void *thread_caching_allocator::reallocate(
+    void *block_to_reallocate_address,
+    size_t new_block_size)
+{
+    auto const block_capacity = get_occupied_block_size(block_to_reallocate_address);
+
+    if (new_block_size <= block_capacity)
+    {
+        return block_to_reallocate_address;
+    }
+
+    auto * const new_block = allocate(new_block_size);
+    memcpy(new_block, block_to_reallocate_address, block_capacity);
+    deallocate(block_to_reallocate_address);
+
+    return new_block;
+}
+
+void *thread_caching_allocator::allocate_aligned(
+    size_t requested_block_size,
+    size_t alignment)
+{
+    if (!is_alignment_valid(alignment))
+    {
+        auto const warning_message = "alignment should be a power of 2";
+
+        this->warning_with_guard(warning_message);
+
+        throw memory_exception(warning_message);
+    }
+
+    if (alignment <= block_header_size)
+    {
+        return allocate(requested_block_size);
+    }
+
+    auto * const origin_block = allocate_with_guard(block_header_size + alignment + requested_block_size);
+    auto * const block_data = reinterpret_cast<unsigned char *>(origin_block) + get_aligned_block_offset(origin_block, block_header_size, alignment, 0) + block_header_size;
+
+    *reinterpret_cast<void **>(reinterpret_cast<size_t *>(block_data) - 2) = origin_block;
+    *(reinterpret_cast<size_t *>(block_data) - 1) = requested_block_size | aligned_block_flag;
+
+    return block_data;
+}
+
+bool thread_caching_allocator::reallocate(
+    void **block_to_reallocate_address_address,
+    size_t new_block_size)
+{
+    try {
+        *block_to_reallocate_address_address = reallocate(*block_to_reallocate_address_address, new_block_size);
+        return true;
+    }
+    catch (std::exception const &ex)
+    {
+        this->warning_with_guard(ex.what());
+        return false;
+    }
+}
+
+logger *thread_caching_allocator::get_logger() const noexcept
+{
+    return *reinterpret_cast<logger **>(reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1) + 1);
+}
+
+std::string thread_caching_allocator::get_typename() const noexcept
+{
+    return "thread_caching_allocator";
+}
+
+allocator *thread_caching_allocator::get_allocator() const noexcept
+{
+    return *reinterpret_cast<allocator **>(reinterpret_cast<size_t *>(_trusted_memory) + 1);
+}
@@ -0,0 +1,126 @@
+#ifndef DATA_STRUCTURES_CPP_THREAD_CACHING_ALLOCATOR_H
+#define DATA_STRUCTURES_CPP_THREAD_CACHING_ALLOCATOR_H
+
+#include <cstddef>
+#include "typename_holder.h"
+#include "logger.h"
+#include "logger_holder.h"
+#include "allocator.h"
+#include "allocator_holder.h"
+
+// front-end keeping per-thread lists of released small blocks; blocks are requested from and returned to
+// the underlying allocator in batches, so only cache misses touch it
+class thread_caching_allocator final:
+    public allocator,
+    protected logger_holder,
+    protected typename_holder,
+    protected allocator_holder
+{
+
+private:
+
+    struct thread_cache_entry;
+
+    struct thread_cache;
+
+private:
+
+    static constexpr size_t size_class_granularity = 16;
+
+    static constexpr size_t size_classes_count = 16;
+
+    static constexpr size_t max_cached_block_size = size_class_granularity * size_classes_count;
+
+    static constexpr size_t aligned_block_flag = ~(~static_cast<size_t>(0) >> 1);
+
+    // block header [aligned block origin address][block capacity] is padded to the fundamental alignment, so block
+    // data keeps the alignment the underlying allocator gives to blocks; cached block links to the next one by its data
+    static constexpr size_t block_header_size = alignof(std::max_align_t);
+
+    static_assert(block_header_size >= sizeof(void *) + sizeof(size_t), "block header should fit origin address and capacity");
+
+private:
+
+    void *_trusted_memory;
+
+public:
+
+    explicit thread_caching_allocator(
+        allocator *underlying_allocator,
+        logger *logger = nullptr,
+        size_t batch_size = 32);
+
+    thread_caching_allocator(
+        thread_caching_allocator const &other) = delete;
+
+    thread_caching_allocator &operator=(
+        thread_caching_allocator const &other) = delete;
+
+    ~thread_caching_allocator() noexcept;
+
+private:
+
+    [[nodiscard]] size_t get_allocator_service_block_size() const noexcept override;
+
+    [[nodiscard]] size_t get_occupied_block_service_block_size() const noexcept override;
+
+    // takes block data address, the capacity is kept in the word before it
+    size_t get_occupied_block_size(
+        void const *current_block_address) const override;
+
+private:
+
+    [[nodiscard]] size_t get_batch_size() const noexcept;
+
+    [[nodiscard]] size_t get_instance_id() const noexcept;
+
+    static size_t get_size_class_index(
+        size_t block_size) noexcept;
+
+    [[nodiscard]] thread_cache_entry *get_thread_cache_entry() const;
+
+    void refill(
+        thread_cache_entry *entry,
+        size_t size_class_index) const;
+
+    void flush(
+        thread_cache_entry *entry,
+        size_t size_class_index,
+        size_t blocks_count) const;
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t requested_block_size) override;
+
+    void deallocate(
+        void *block_to_deallocate_address) override;
+
+    [[nodiscard]] void *reallocate(
+        void *block_to_reallocate_address,
+        size_t new_block_size) override;
+
+    bool reallocate(
+        void **block_to_reallocate_address_address,
+        size_t new_block_size) override;
+
+    // blocks aligned beyond the block header size bypass the cache
+    [[nodiscard]] void *allocate_aligned(
+        size_t requested_block_size,
+        size_t alignment) override;
+
+private:
+
+    [[nodiscard]] logger *get_logger() const noexcept override;
+
+private:
+
+    [[nodiscard]] std::string get_typename() const noexcept override;
+
+private:
+
+    [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+};
+
+#endif // DATA_STRUCTURES_CPP_THREAD_CACHING_ALLOCATOR_H
@@ -0,0 +1,163 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../allocator/allocator.h"
+#include "../allocator/allocator_fit_allocation.h"
+#include "../allocator/allocator_sorted_list.h"
+#include "../allocator/allocator_double_system.h"
+
+// Mixed-size churn: random allocations (mostly small, sometimes large) interleaved with random deallocations
+// of live blocks. Every engine replays the same operations sequence.
+
+namespace
+{
+
+    struct churn_operation
+    {
+        bool is_allocation;
+        size_t value;
+    };
+
+    size_t const trusted_memory_size = 64 * 1024 * 1024;
+    size_t const live_blocks_limit = 4096;
+    size_t const operations_count = 2000000;
+
+    size_t generate_block_size(
+        std::mt19937_64 &engine)
+    {
+        auto const kind = engine() % 100;
+
+        if (kind < 70)
+        {
+            return 16 + engine() % 112;
+        }
+
+        if (kind < 95)
+        {
+            return 128 + engine() % 896;
+        }
+
+        return 1024 + engine() % 7168;
+    }
+
+    std::vector<churn_operation> generate_operations()
+    {
+        std::mt19937_64 engine(20240617);
+        std::vector<churn_operation> operations;
+        operations.reserve(operations_count);
+        size_t live_blocks_count = 0;
+
+        for (size_t i = 0; i < operations_count; i++)
+        {
+            auto const is_allocation = live_blocks_count == 0 ||
+                (live_blocks_count < live_blocks_limit && engine() % 2 == 0);
+
+            if (is_allocation)
+            {
+                operations.push_back({ true, generate_block_size(engine) });
+                ++live_blocks_count;
+            }
+            else
+            {
+                operations.push_back({ false, static_cast<size_t>(engine() % live_blocks_count) });
+                --live_blocks_count;
+            }
+        }
+
+        return operations;
+    }
+
+    void run(
+        std::string const &name,
+        allocator *allocator_to_benchmark,
+        std::vector<churn_operation> const &operations)
+    {
+        std::vector<void *> live_blocks;
+        live_blocks.reserve(live_blocks_limit);
+        size_t failed_allocations_count = 0;
+
+        auto const started_at = std::chrono::steady_clock::now();
+
+        for (auto const &operation : operations)
+        {
+            if (operation.is_allocation)
+            {
+                try
+                {
+                    auto *block = allocator_to_benchmark->allocate(operation.value);
+                    *reinterpret_cast<unsigned char *>(block) = 0;
+                    live_blocks.push_back(block);
+                }
+                catch (allocator::memory_exception const &)
+                {
+                    ++failed_allocations_count;
+                    live_blocks.push_back(nullptr);
+                }
+            }
+            else
+            {
+                auto *block = live_blocks[operation.value];
+                live_blocks[operation.value] = live_blocks.back();
+                live_blocks.pop_back();
+
+                if (block != nullptr)
+                {
+                    allocator_to_benchmark->deallocate(block);
+                }
+            }
+        }
+
+        auto const finished_at = std::chrono::steady_clock::now();
+
+        for (auto *block : live_blocks)
+        {
+            if (block != nullptr)
+            {
+                allocator_to_benchmark->deallocate(block);
+            }
+        }
+
+        auto const elapsed = std::chrono::duration<double, std::nano>(finished_at - started_at).count();
+
+        std::cout << std::left << std::setw(40) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed / operations.size() << " ns/op"
+                  << std::setw(12) << failed_allocations_count << " failed allocations" << std::endl;
+    }
+
+}
+
+int main()
+{
+    auto const operations = generate_operations();
+
+    std::cout << "Mixed-size churn, " << operations.size() << " operations, up to " << live_blocks_limit << " live blocks" << std::endl;
+
+    std::pair<std::string, allocator_fit_allocation::allocation_mode> const modes[] =
+    {
+        { "first fit", allocator_fit_allocation::allocation_mode::first_fit },
+        { "the best fit", allocator_fit_allocation::allocation_mode::the_best_fit },
+        { "the worst fit", allocator_fit_allocation::allocation_mode::the_worst_fit },
+        { "next fit", allocator_fit_allocation::allocation_mode::next_fit }
+    };
+
+    for (auto const &mode : modes)
+    {
+        {
+            allocator_sorted_list engine(trusted_memory_size, nullptr, nullptr, mode.second);
+            run("allocator_sorted_list, " + mode.first, &engine, operations);
+        }
+
+        // buddy system has no position to resume next fit search from and rejects it
+        if (mode.second != allocator_fit_allocation::allocation_mode::next_fit)
+        {
+            allocator_double_system engine(trusted_memory_size, nullptr, nullptr, mode.second);
+            run("allocator_double_system, " + mode.first, &engine, operations);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../allocator/allocator.h"
+#include "../allocator/allocator_fit_allocation.h"
+#include "../allocator/allocator_sorted_list.h"
+#include "../allocator/allocator_descriptor.h"
+
+// Fit modes compared on a heap kept close to full by mixed-size churn. For every engine and mode the same
+// operations sequence is replayed and reported:
+//   - throughput;
+//   - allocations failed for lack of a fitting block;
+//   - the largest block still allocatable after the churn, while the surviving blocks are live.
+
+namespace
+{
+
+    struct churn_operation
+    {
+        bool is_allocation;
+        size_t value;
+    };
+
+    size_t const trusted_memory_size = 2 * 1024 * 1024;
+    size_t const live_blocks_limit = 4096;
+    size_t const operations_count = 1000000;
+
+    size_t generate_block_size(
+        std::mt19937_64 &engine)
+    {
+        auto const kind = engine() % 100;
+
+        if (kind < 70)
+        {
+            return 16 + engine() % 112;
+        }
+
+        if (kind < 95)
+        {
+            return 128 + engine() % 896;
+        }
+
+        return 1024 + engine() % 7168;
+    }
+
+    // allocations prevail, so the number of live blocks stays close to the limit and the heap close to full
+    std::vector<churn_operation> generate_operations()
+    {
+        std::mt19937_64 engine(20240701);
+        std::vector<churn_operation> operations;
+        operations.reserve(operations_count);
+        size_t live_blocks_count = 0;
+
+        for (size_t i = 0; i < operations_count; i++)
+        {
+            auto const is_allocation = live_blocks_count == 0 ||
+                (live_blocks_count < live_blocks_limit && engine() % 4 != 0);
+
+            if (is_allocation)
+            {
+                operations.push_back({ true, generate_block_size(engine) });
+                ++live_blocks_count;
+            }
+            else
+            {
+                operations.push_back({ false, static_cast<size_t>(engine() % live_blocks_count) });
+                --live_blocks_count;
+            }
+        }
+
+        return operations;
+    }
+
+    size_t get_largest_allocatable_block_size(
+        allocator *allocator_to_probe)
+    {
+        size_t lower_bound = 0, upper_bound = trusted_memory_size;
+
+        while (lower_bound < upper_bound)
+        {
+            auto const block_size = (lower_bound + upper_bound + 1) / 2;
+            auto *block = allocator_to_probe->try_allocate(block_size);
+
+            if (block == nullptr)
+            {
+                upper_bound = block_size - 1;
+            }
+            else
+            {
+                allocator_to_probe->deallocate(block);
+                lower_bound = block_size;
+            }
+        }
+
+        return lower_bound;
+    }
+
+    void run(
+        std::string const &name,
+        allocator *allocator_to_benchmark,
+        std::vector<churn_operation> const &operations)
+    {
+        std::vector<void *> live_blocks;
+        live_blocks.reserve(live_blocks_limit);
+        size_t failed_allocations_count = 0;
+
+        auto const started_at = std::chrono::steady_clock::now();
+
+        for (auto const &operation : operations)
+        {
+            if (operation.is_allocation)
+            {
+                auto *block = allocator_to_benchmark->try_allocate(operation.value);
+
+                if (block == nullptr)
+                {
+                    ++failed_allocations_count;
+                }
+
+                live_blocks.push_back(block);
+            }
+            else
+            {
+                auto *block = live_blocks[operation.value];
+                live_blocks[operation.value] = live_blocks.back();
+                live_blocks.pop_back();
+
+                if (block != nullptr)
+                {
+                    allocator_to_benchmark->deallocate(block);
+                }
+            }
+        }
+
+        auto const finished_at = std::chrono::steady_clock::now();
+        auto const largest_allocatable_block_size = get_largest_allocatable_block_size(allocator_to_benchmark);
+
+        for (auto *block : live_blocks)
+        {
+            if (block != nullptr)
+            {
+                allocator_to_benchmark->deallocate(block);
+            }
+        }
+
+        auto const elapsed = std::chrono::duration<double, std::nano>(finished_at - started_at).count();
+
+        std::cout << std::left << std::setw(40) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed / operations.size() << " ns/op"
+                  << std::setw(10) << failed_allocations_count << " failed allocations"
+                  << std::setw(10) << largest_allocatable_block_size << " bytes largest block" << std::endl;
+    }
+
+}
+
+int main()
+{
+    auto const operations = generate_operations();
+
+    std::cout << "Fit modes under memory pressure, " << operations.size() << " operations, up to " << live_blocks_limit
+              << " live blocks in " << trusted_memory_size << " bytes" << std::endl;
+
+    std::pair<std::string, allocator_fit_allocation::allocation_mode> const modes[] =
+    {
+        { "first fit", allocator_fit_allocation::allocation_mode::first_fit },
+        { "next fit", allocator_fit_allocation::allocation_mode::next_fit },
+        { "the best fit", allocator_fit_allocation::allocation_mode::the_best_fit },
+        { "the worst fit", allocator_fit_allocation::allocation_mode::the_worst_fit }
+    };
+
+    for (auto const &mode : modes)
+    {
+        {
+            allocator_sorted_list engine(trusted_memory_size, nullptr, nullptr, mode.second);
+            run("allocator_sorted_list, " + mode.first, &engine, operations);
+        }
+
+        {
+            allocator_descriptor engine(trusted_memory_size, nullptr, nullptr, mode.second);
+            run("allocator_descriptor, " + mode.first, &engine, operations);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../allocator/allocator.h"
+#include "../allocator/allocator_fit_allocation.h"
+#include "../allocator/allocator_sorted_list.h"
+#include "../allocator/allocator_descriptor.h"
+#include "../allocator/allocator_double_system.h"
+#include "../allocator/allocator_red_black_tree.h"
+#include "../allocator/allocator_tlsf.h"
+
+// Per-call latency of allocate and deallocate on a fragmented heap. Every engine replays the same operations
+// sequence; percentiles are reported separately for both methods.
+
+namespace
+{
+
+    struct churn_operation
+    {
+        bool is_allocation;
+        size_t value;
+    };
+
+    size_t const trusted_memory_size = 64 * 1024 * 1024;
+    size_t const live_blocks_limit = 16384;
+    size_t const operations_count = 1000000;
+
+    std::vector<churn_operation> generate_operations()
+    {
+        std::mt19937_64 engine(20240618);
+        std::vector<churn_operation> operations;
+        operations.reserve(operations_count);
+        size_t live_blocks_count = 0;
+
+        for (size_t i = 0; i < operations_count; i++)
+        {
+            auto const is_allocation = live_blocks_count == 0 ||
+                (live_blocks_count < live_blocks_limit && engine() % 2 == 0);
+
+            if (is_allocation)
+            {
+                auto const kind = engine() % 100;
+                operations.push_back({ true, kind < 80
+                    ? 8 + engine() % 248
+                    : 256 + engine() % 3840 });
+                ++live_blocks_count;
+            }
+            else
+            {
+                operations.push_back({ false, static_cast<size_t>(engine() % live_blocks_count) });
+                --live_blocks_count;
+            }
+        }
+
+        return operations;
+    }
+
+    std::string percentiles_to_string(
+        std::vector<double> &latencies)
+    {
+        if (latencies.empty())
+        {
+            return "no samples";
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        auto const percentile = [&latencies](double rank)
+        {
+            return latencies[static_cast<size_t>(rank * (latencies.size() - 1))];
+        };
+
+        std::ostringstream result;
+        result << std::fixed << std::setprecision(0)
+               << "p50 " << std::setw(7) << percentile(0.5)
+               << "  p99 " << std::setw(7) << percentile(0.99)
+               << "  max " << std::setw(9) << latencies.back();
+
+        return result.str();
+    }
+
+    void run(
+        std::string const &name,
+        allocator *allocator_to_benchmark,
+        std::vector<churn_operation> const &operations)
+    {
+        std::vector<void *> live_blocks;
+        live_blocks.reserve(live_blocks_limit);
+        std::vector<double> allocate_latencies, deallocate_latencies;
+        allocate_latencies.reserve(operations.size());
+        deallocate_latencies.reserve(operations.size());
+
+        for (auto const &operation : operations)
+        {
+            if (operation.is_allocation)
+            {
+                void *block = nullptr;
+                auto const started_at = std::chrono::steady_clock::now();
+
+                try
+                {
+                    block = allocator_to_benchmark->allocate(operation.value);
+                }
+                catch (allocator::memory_exception const &)
+                {
+
+                }
+
+                auto const finished_at = std::chrono::steady_clock::now();
+                allocate_latencies.push_back(std::chrono::duration<double, std::nano>(finished_at - started_at).count());
+                live_blocks.push_back(block);
+            }
+            else
+            {
+                auto *block = live_blocks[operation.value];
+                live_blocks[operation.value] = live_blocks.back();
+                live_blocks.pop_back();
+
+                if (block == nullptr)
+                {
+                    continue;
+                }
+
+                auto const started_at = std::chrono::steady_clock::now();
+                allocator_to_benchmark->deallocate(block);
+                auto const finished_at = std::chrono::steady_clock::now();
+                deallocate_latencies.push_back(std::chrono::duration<double, std::nano>(finished_at - started_at).count());
+            }
+        }
+
+        for (auto *block : live_blocks)
+        {
+            if (block != nullptr)
+            {
+                allocator_to_benchmark->deallocate(block);
+            }
+        }
+
+        std::cout << std::left << std::setw(28) << name << "allocate   [ns]: " << percentiles_to_string(allocate_latencies) << std::endl
+                  << std::left << std::setw(28) << "" << "deallocate [ns]: " << percentiles_to_string(deallocate_latencies) << std::endl;
+    }
+
+}
+
+int main()
+{
+    auto const operations = generate_operations();
+    auto const mode = allocator_fit_allocation::allocation_mode::the_best_fit;
+
+    std::cout << "Allocation latency, " << operations.size() << " operations, up to " << live_blocks_limit << " live blocks, the best fit" << std::endl;
+
+    {
+        allocator_sorted_list engine(trusted_memory_size, nullptr, nullptr, mode);
+        run("allocator_sorted_list", &engine, operations);
+    }
+
+    {
+        allocator_descriptor engine(trusted_memory_size, nullptr, nullptr, mode);
+        run("allocator_descriptor", &engine, operations);
+    }
+
+    {
+        allocator_double_system engine(trusted_memory_size, nullptr, nullptr, mode);
+        run("allocator_double_system", &engine, operations);
+    }
+
+    {
+        allocator_red_black_tree engine(trusted_memory_size, nullptr, nullptr, mode);
+        run("allocator_red_black_tree", &engine, operations);
+    }
+
+    {
+        allocator_tlsf engine(trusted_memory_size, nullptr, nullptr, mode);
+        run("allocator_tlsf", &engine, operations);
+    }
+
+    return 0;
+}
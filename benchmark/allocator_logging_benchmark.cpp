@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../allocator/allocator.h"
+#include "../allocator/allocator_fit_allocation.h"
+#include "../allocator/allocator_sorted_list.h"
+#include "../allocator/allocator_tlsf.h"
+#include "../allocator/allocator_double_system.h"
+#include "../allocator/logger.h"
+
+// Allocation throughput with no logger and with a logger which accepts nothing below warnings, best of several runs.
+// Building benchmark and allocators with -DLOGGER_HOLDER_DISABLE_LOGGING compiles logging out and gives
+// the uninstrumented baseline to compare both columns with.
+
+namespace
+{
+
+    size_t const trusted_memory_size = 64 * 1024 * 1024;
+    size_t const live_blocks_limit = 1024;
+    size_t const operations_count = 2000000;
+    size_t const runs_count = 5;
+
+    class discarding_logger final:
+        public logger
+    {
+
+    private:
+
+        logger::severity _minimal_severity;
+
+    public:
+
+        explicit discarding_logger(
+            logger::severity minimal_severity):
+            _minimal_severity(minimal_severity)
+        {
+
+        }
+
+    public:
+
+        logger const *log(
+            std::string const &,
+            logger::severity) const noexcept override
+        {
+            return this;
+        }
+
+        bool is_enabled(
+            logger::severity severity) const noexcept override
+        {
+            return severity >= _minimal_severity;
+        }
+
+    };
+
+    double run_once(
+        allocator *allocator_to_benchmark)
+    {
+        std::mt19937_64 engine(20240624);
+        std::vector<void *> live_blocks;
+        live_blocks.reserve(live_blocks_limit);
+
+        auto const started_at = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < operations_count; i++)
+        {
+            if (live_blocks.empty() || (live_blocks.size() < live_blocks_limit && engine() % 2 == 0))
+            {
+                live_blocks.push_back(allocator_to_benchmark->allocate(16 + engine() % 240));
+            }
+            else
+            {
+                auto const index = engine() % live_blocks.size();
+                allocator_to_benchmark->deallocate(live_blocks[index]);
+                live_blocks[index] = live_blocks.back();
+                live_blocks.pop_back();
+            }
+        }
+
+        auto const finished_at = std::chrono::steady_clock::now();
+
+        for (auto *block : live_blocks)
+        {
+            allocator_to_benchmark->deallocate(block);
+        }
+
+        return static_cast<double>(operations_count) / std::chrono::duration<double>(finished_at - started_at).count() / 1e6;
+    }
+
+    double run(
+        allocator *allocator_to_benchmark)
+    {
+        double best_throughput = 0;
+
+        for (size_t i = 0; i < runs_count; i++)
+        {
+            best_throughput = std::max(best_throughput, run_once(allocator_to_benchmark));
+        }
+
+        return best_throughput;
+    }
+
+    template<
+        typename engine_type>
+    void run_engine(
+        std::string const &name)
+    {
+        auto const mode = allocator_fit_allocation::allocation_mode::first_fit;
+        discarding_logger quiet_logger(logger::severity::warning);
+
+        engine_type engine_without_logger(trusted_memory_size, nullptr, nullptr, mode);
+        engine_type engine_with_quiet_logger(trusted_memory_size, nullptr, &quiet_logger, mode);
+
+        auto const without_logger_throughput = run(&engine_without_logger);
+        auto const with_quiet_logger_throughput = run(&engine_with_quiet_logger);
+
+        std::cout << std::fixed << std::setprecision(2) << std::left
+                  << std::setw(28) << name
+                  << std::setw(16) << without_logger_throughput
+                  << std::setw(16) << with_quiet_logger_throughput << std::endl;
+    }
+
+}
+
+int main()
+{
+#ifdef LOGGER_HOLDER_DISABLE_LOGGING
+    std::cout << "Logging compiled out" << std::endl;
+#endif
+
+    std::cout << "Allocation throughput [Mops/s]" << std::endl
+              << std::left << std::setw(28) << "engine"
+              << std::setw(16) << "no logger"
+              << std::setw(16) << "warnings only" << std::endl;
+
+    run_engine<allocator_sorted_list>("allocator_sorted_list");
+    run_engine<allocator_tlsf>("allocator_tlsf");
+    run_engine<allocator_double_system>("allocator_double_system");
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "../allocator/allocator.h"
+#include "../allocator/allocator_fit_allocation.h"
+#include "../allocator/allocator_tlsf.h"
+#include "../allocator/allocator_mmap.h"
+
+// Page faults and TLB misses on a large heap whose trusted memory comes from ::operator new or from
+// allocator_mmap with regular, transparent huge and huge pages, with and without prefaulting. The heap is filled
+// with blocks which are written once (first touch) and then read at random offsets (TLB reach).
+
+namespace
+{
+
+    size_t const trusted_memory_size = 1024 * 1024 * 1024;
+    size_t const block_size = 64 * 1024;
+    size_t const random_reads_count = 16 * 1024 * 1024;
+
+    // keeps random reads from being optimized away
+    size_t volatile checksum_sink;
+
+    // dTLB read misses of the calling thread, when the kernel lets us count them
+    class tlb_misses_counter final
+    {
+
+    private:
+
+        int _descriptor;
+
+    public:
+
+        tlb_misses_counter():
+            _descriptor(-1)
+        {
+#if defined(__linux__)
+            perf_event_attr attributes;
+            memset(&attributes, 0, sizeof(attributes));
+            attributes.type = PERF_TYPE_HW_CACHE;
+            attributes.size = sizeof(attributes);
+            attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+
+            _descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+        }
+
+        ~tlb_misses_counter() noexcept
+        {
+#if defined(__linux__)
+            if (_descriptor != -1)
+            {
+                close(_descriptor);
+            }
+#endif
+        }
+
+        tlb_misses_counter(
+            tlb_misses_counter const &) = delete;
+
+        tlb_misses_counter &operator=(
+            tlb_misses_counter const &) = delete;
+
+    public:
+
+        void start()
+        {
+#if defined(__linux__)
+            if (_descriptor != -1)
+            {
+                ioctl(_descriptor, PERF_EVENT_IOC_RESET, 0);
+                ioctl(_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        std::string stop()
+        {
+#if defined(__linux__)
+            long long misses = 0;
+
+            if (_descriptor != -1)
+            {
+                ioctl(_descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+                if (read(_descriptor, &misses, sizeof(misses)) == sizeof(misses))
+                {
+                    return std::to_string(misses);
+                }
+            }
+#endif
+            return "n/a";
+        }
+
+    };
+
+    long minor_page_faults_count()
+    {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        return usage.ru_minflt;
+    }
+
+    double milliseconds_since(
+        std::chrono::steady_clock::time_point started_at)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started_at).count();
+    }
+
+    void run(
+        std::string const &name,
+        std::function<allocator *()> const &outer_allocator_factory)
+    {
+        std::unique_ptr<allocator> outer_allocator(outer_allocator_factory());
+        tlb_misses_counter tlb_misses;
+
+        auto const faults_before_construction = minor_page_faults_count();
+        auto started_at = std::chrono::steady_clock::now();
+
+        allocator_tlsf engine(trusted_memory_size, outer_allocator.get(), nullptr, allocator_fit_allocation::allocation_mode::first_fit);
+
+        auto const construction_milliseconds = milliseconds_since(started_at);
+        auto const construction_faults = minor_page_faults_count() - faults_before_construction;
+
+        std::vector<unsigned char *> blocks;
+        blocks.reserve(trusted_memory_size / block_size);
+
+        auto const faults_before_touch = minor_page_faults_count();
+        started_at = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i + 1 < trusted_memory_size / block_size; i++)
+        {
+            auto * const block = reinterpret_cast<unsigned char *>(engine.allocate(block_size - 64));
+            memset(block, static_cast<int>(i), block_size - 64);
+            blocks.push_back(block);
+        }
+
+        auto const touch_milliseconds = milliseconds_since(started_at);
+        auto const touch_faults = minor_page_faults_count() - faults_before_touch;
+
+        std::mt19937_64 random(20240620);
+        size_t checksum = 0;
+
+        tlb_misses.start();
+        started_at = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < random_reads_count; i++)
+        {
+            auto const random_value = random();
+            checksum += blocks[random_value % blocks.size()][(random_value >> 32) % (block_size - 64)];
+        }
+
+        auto const random_reads_milliseconds = milliseconds_since(started_at);
+        auto const random_reads_tlb_misses = tlb_misses.stop();
+        checksum_sink = checksum;
+
+        for (auto *block : blocks)
+        {
+            engine.deallocate(block);
+        }
+
+        std::cout << std::fixed << std::setprecision(1) << std::left
+                  << std::setw(30) << name
+                  << std::setw(14) << construction_milliseconds
+                  << std::setw(14) << construction_faults
+                  << std::setw(14) << touch_milliseconds
+                  << std::setw(14) << touch_faults
+                  << std::setw(14) << random_reads_milliseconds
+                  << std::setw(14) << random_reads_tlb_misses << std::endl;
+    }
+
+}
+
+int main()
+{
+    std::cout << "allocator_tlsf with " << (trusted_memory_size >> 20) << " MB of trusted memory, "
+              << (block_size >> 10) << " KB blocks, " << random_reads_count << " random reads" << std::endl
+              << std::left << std::setw(30) << "trusted memory"
+              << std::setw(14) << "ctor [ms]"
+              << std::setw(14) << "ctor faults"
+              << std::setw(14) << "touch [ms]"
+              << std::setw(14) << "touch faults"
+              << std::setw(14) << "reads [ms]"
+              << std::setw(14) << "dTLB misses" << std::endl;
+
+    run("::operator new", []() -> allocator * { return nullptr; });
+    run("mmap", []() -> allocator * { return new allocator_mmap(); });
+    run("mmap, populate", []() -> allocator * { return new allocator_mmap(allocator_mmap::pages_mode::regular_pages, true); });
+    run("mmap, transparent huge pages", []() -> allocator * { return new allocator_mmap(allocator_mmap::pages_mode::transparent_huge_pages); });
+    run("mmap, thp, populate", []() -> allocator * { return new allocator_mmap(allocator_mmap::pages_mode::transparent_huge_pages, true); });
+    run("mmap, huge pages", []() -> allocator * { return new allocator_mmap(allocator_mmap::pages_mode::huge_pages); });
+
+    return 0;
+}
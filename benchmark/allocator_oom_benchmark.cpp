@@ -0,0 +1,270 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "../allocator/allocator.h"
+#include "../allocator/allocator_fit_allocation.h"
+#include "../allocator/allocator_sorted_list.h"
+#include "../allocator/allocator_descriptor.h"
+#include "../allocator/allocator_red_black_tree.h"
+#include "../allocator/allocator_tlsf.h"
+#include "../allocator/allocator_double_system.h"
+
+// Churn on a heap kept close to exhaustion, so most of allocations fail. Every engine replays the same operations
+// sequence twice: through the throwing `allocate`/`reallocate` with failures caught and through
+// `try_allocate`/`try_reallocate`, which report failures by nullptr. Before the churn every fit engine is checked to
+// reject requests so huge that block headers and alignment padding added to them would wrap around.
+
+namespace
+{
+
+    struct oom_operation
+    {
+        enum class kind
+        {
+            allocation,
+            reallocation,
+            deallocation
+        };
+
+        kind operation_kind;
+        size_t value;
+        size_t block_size;
+    };
+
+    size_t const trusted_memory_size = 1024 * 1024;
+    size_t const live_blocks_limit = 4096;
+    size_t const operations_count = 1000000;
+
+    std::vector<oom_operation> generate_operations()
+    {
+        std::mt19937_64 engine(20240623);
+        std::vector<oom_operation> operations;
+        operations.reserve(operations_count);
+        size_t live_blocks_count = 0;
+
+        // live blocks limit times average block size is far beyond trusted memory size, so the heap stays full
+        for (size_t i = 0; i < operations_count; i++)
+        {
+            auto const choice = engine() % 100;
+            auto const block_size = 256 + engine() % 1792;
+
+            if (live_blocks_count == 0 || (live_blocks_count < live_blocks_limit && choice < 60))
+            {
+                operations.push_back({ oom_operation::kind::allocation, 0, block_size });
+                ++live_blocks_count;
+            }
+            else if (choice < 80)
+            {
+                operations.push_back({ oom_operation::kind::reallocation, static_cast<size_t>(engine() % live_blocks_count), block_size * 2 });
+            }
+            else
+            {
+                operations.push_back({ oom_operation::kind::deallocation, static_cast<size_t>(engine() % live_blocks_count), 0 });
+                --live_blocks_count;
+            }
+        }
+
+        return operations;
+    }
+
+    void *allocate_catching(
+        allocator *allocator_to_benchmark,
+        size_t block_size)
+    {
+        try
+        {
+            return allocator_to_benchmark->allocate(block_size);
+        }
+        catch (allocator::memory_exception const &)
+        {
+            return nullptr;
+        }
+    }
+
+    void *reallocate_catching(
+        allocator *allocator_to_benchmark,
+        void *block,
+        size_t block_size)
+    {
+        try
+        {
+            return allocator_to_benchmark->reallocate(block, block_size);
+        }
+        catch (allocator::memory_exception const &)
+        {
+            return nullptr;
+        }
+    }
+
+    bool allocate_batch_catching(
+        allocator *allocator_to_check,
+        size_t block_size)
+    {
+        void *blocks[2];
+
+        try
+        {
+            allocator_to_check->allocate_batch(block_size, 2, blocks);
+            return true;
+        }
+        catch (allocator::memory_exception const &)
+        {
+            return false;
+        }
+    }
+
+    template<
+        typename engine_type>
+    bool check_huge_requests(
+        std::string const &name)
+    {
+        engine_type engine(trusted_memory_size, nullptr, nullptr, allocator_fit_allocation::allocation_mode::first_fit);
+        auto *block = engine.allocate(16);
+        auto is_rejected = true;
+
+        for (auto const block_size : { std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max() - 7 })
+        {
+            is_rejected &= engine.try_allocate(block_size) == nullptr;
+            is_rejected &= allocate_catching(&engine, block_size) == nullptr;
+            is_rejected &= engine.try_reallocate(block, block_size) == nullptr;
+            is_rejected &= reallocate_catching(&engine, block, block_size) == nullptr;
+            is_rejected &= !allocate_batch_catching(&engine, block_size);
+        }
+
+        engine.deallocate(block);
+
+        std::cout << std::left << std::setw(48) << name << (is_rejected ? "huge requests rejected" : "huge requests NOT rejected") << std::endl;
+
+        return is_rejected;
+    }
+
+    template<
+        bool is_throwing>
+    void run(
+        std::string const &name,
+        allocator *allocator_to_benchmark,
+        std::vector<oom_operation> const &operations)
+    {
+        std::vector<void *> live_blocks;
+        live_blocks.reserve(live_blocks_limit);
+        size_t failed_operations_count = 0;
+
+        auto const started_at = std::chrono::steady_clock::now();
+
+        for (auto const &operation : operations)
+        {
+            switch (operation.operation_kind)
+            {
+                case oom_operation::kind::allocation:
+                {
+                    auto *block = is_throwing
+                        ? allocate_catching(allocator_to_benchmark, operation.block_size)
+                        : allocator_to_benchmark->try_allocate(operation.block_size);
+
+                    failed_operations_count += block == nullptr;
+                    live_blocks.push_back(block);
+                    break;
+                }
+                case oom_operation::kind::reallocation:
+                {
+                    auto *&block = live_blocks[operation.value];
+
+                    if (block == nullptr)
+                    {
+                        break;
+                    }
+
+                    auto *reallocated_block = is_throwing
+                        ? reallocate_catching(allocator_to_benchmark, block, operation.block_size)
+                        : allocator_to_benchmark->try_reallocate(block, operation.block_size);
+
+                    if (reallocated_block == nullptr)
+                    {
+                        ++failed_operations_count;
+                    }
+                    else
+                    {
+                        block = reallocated_block;
+                    }
+                    break;
+                }
+                case oom_operation::kind::deallocation:
+                {
+                    auto *block = live_blocks[operation.value];
+                    live_blocks[operation.value] = live_blocks.back();
+                    live_blocks.pop_back();
+
+                    if (block != nullptr)
+                    {
+                        allocator_to_benchmark->deallocate(block);
+                    }
+                    break;
+                }
+            }
+        }
+
+        auto const finished_at = std::chrono::steady_clock::now();
+
+        for (auto *block : live_blocks)
+        {
+            if (block != nullptr)
+            {
+                allocator_to_benchmark->deallocate(block);
+            }
+        }
+
+        auto const elapsed = std::chrono::duration<double, std::nano>(finished_at - started_at).count();
+
+        std::cout << std::left << std::setw(48) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed / operations.size() << " ns/op"
+                  << std::setw(12) << failed_operations_count << " failed operations" << std::endl;
+    }
+
+    template<
+        typename engine_type>
+    void run_engine(
+        std::string const &name,
+        std::vector<oom_operation> const &operations)
+    {
+        auto const mode = allocator_fit_allocation::allocation_mode::first_fit;
+
+        {
+            engine_type engine(trusted_memory_size, nullptr, nullptr, mode);
+            run<true>(name + ", exceptions", &engine, operations);
+        }
+
+        {
+            engine_type engine(trusted_memory_size, nullptr, nullptr, mode);
+            run<false>(name + ", try_allocate", &engine, operations);
+        }
+    }
+
+}
+
+int main()
+{
+    auto const are_huge_requests_rejected = check_huge_requests<allocator_sorted_list>("allocator_sorted_list")
+        & check_huge_requests<allocator_descriptor>("allocator_descriptor")
+        & check_huge_requests<allocator_red_black_tree>("allocator_red_black_tree")
+        & check_huge_requests<allocator_tlsf>("allocator_tlsf")
+        & check_huge_requests<allocator_double_system>("allocator_double_system");
+
+    if (!are_huge_requests_rejected)
+    {
+        return 1;
+    }
+
+    auto const operations = generate_operations();
+
+    std::cout << "Churn close to exhaustion, " << operations.size() << " operations on " << trusted_memory_size << " bytes heap" << std::endl;
+
+    run_engine<allocator_sorted_list>("allocator_sorted_list", operations);
+    run_engine<allocator_tlsf>("allocator_tlsf", operations);
+    run_engine<allocator_double_system>("allocator_double_system", operations);
+
+    return 0;
+}
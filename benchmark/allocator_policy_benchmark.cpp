@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../allocator/allocator.h"
+#include "../allocator/allocator_fit_allocation.h"
+#include "../allocator/allocator_descriptor.h"
+#include "../allocator/basic_fit_allocator.h"
+
+// Churn throughput of allocator_descriptor against basic_fit_allocator, which keeps the same block layout but
+// resolves fit mode, lock and logging at compile time, best of several runs:
+//   - allocator_descriptor called through allocator *;
+//   - basic_fit_allocator behind fit_allocator_adapter, called through allocator *;
+//   - basic_fit_allocator with the same policies as allocator_descriptor, called directly;
+//   - basic_fit_allocator with no lock and no logging, called directly;
+//   - the same with 32-bit boundary tags and links (compact_block_header_policy).
+
+namespace
+{
+
+    size_t const trusted_memory_size = 64 * 1024 * 1024;
+    size_t const live_blocks_limit = 1024;
+    size_t const operations_count = 2000000;
+    size_t const runs_count = 5;
+
+    template<
+        typename engine_type>
+    double run_once(
+        engine_type &engine_to_benchmark)
+    {
+        std::mt19937_64 engine(20240627);
+        std::vector<void *> live_blocks;
+        live_blocks.reserve(live_blocks_limit);
+
+        auto const started_at = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < operations_count; i++)
+        {
+            if (live_blocks.empty() || (live_blocks.size() < live_blocks_limit && engine() % 2 == 0))
+            {
+                live_blocks.push_back(engine_to_benchmark.allocate(16 + engine() % 240));
+            }
+            else
+            {
+                auto const index = engine() % live_blocks.size();
+                engine_to_benchmark.deallocate(live_blocks[index]);
+                live_blocks[index] = live_blocks.back();
+                live_blocks.pop_back();
+            }
+        }
+
+        auto const finished_at = std::chrono::steady_clock::now();
+
+        for (auto *block : live_blocks)
+        {
+            engine_to_benchmark.deallocate(block);
+        }
+
+        return static_cast<double>(operations_count) / std::chrono::duration<double>(finished_at - started_at).count() / 1e6;
+    }
+
+    template<
+        typename engine_type>
+    double run(
+        engine_type &engine_to_benchmark)
+    {
+        double best_throughput = 0;
+
+        for (size_t i = 0; i < runs_count; i++)
+        {
+            best_throughput = std::max(best_throughput, run_once(engine_to_benchmark));
+        }
+
+        return best_throughput;
+    }
+
+    template<
+        typename fit_policy>
+    void run_mode(
+        std::string const &name,
+        allocator_fit_allocation::allocation_mode mode)
+    {
+        allocator_descriptor descriptor(trusted_memory_size, nullptr, nullptr, mode);
+        fit_allocator_adapter<basic_fit_allocator<fit_policy>> adapter(trusted_memory_size);
+        basic_fit_allocator<fit_policy> same_policies(trusted_memory_size);
+        basic_fit_allocator<fit_policy, no_lock_policy, no_log_policy, new_delete_backing_policy> bare(trusted_memory_size);
+        basic_fit_allocator<fit_policy, no_lock_policy, no_log_policy, new_delete_backing_policy, compact_block_header_policy> compact(trusted_memory_size);
+
+        auto const descriptor_throughput = run(*static_cast<allocator *>(&descriptor));
+        auto const adapter_throughput = run(*static_cast<allocator *>(&adapter));
+        auto const same_policies_throughput = run(same_policies);
+        auto const bare_throughput = run(bare);
+        auto const compact_throughput = run(compact);
+
+        std::cout << std::fixed << std::setprecision(2) << std::left
+                  << std::setw(16) << name
+                  << std::setw(16) << descriptor_throughput
+                  << std::setw(16) << adapter_throughput
+                  << std::setw(16) << same_policies_throughput
+                  << std::setw(16) << bare_throughput
+                  << std::setw(16) << compact_throughput << std::endl;
+    }
+
+}
+
+int main()
+{
+    std::cout << "Allocation throughput [Mops/s]" << std::endl
+              << std::left << std::setw(16) << "mode"
+              << std::setw(16) << "descriptor"
+              << std::setw(16) << "adapter"
+              << std::setw(16) << "template"
+              << std::setw(16) << "no lock/log"
+              << std::setw(16) << "compact" << std::endl;
+
+    run_mode<first_fit_policy>("first fit", allocator_fit_allocation::allocation_mode::first_fit);
+    run_mode<the_best_fit_policy>("the best fit", allocator_fit_allocation::allocation_mode::the_best_fit);
+    run_mode<the_worst_fit_policy>("the worst fit", allocator_fit_allocation::allocation_mode::the_worst_fit);
+
+    return 0;
+}
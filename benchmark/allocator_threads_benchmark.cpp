@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../allocator/allocator.h"
+#include "../allocator/allocator_fit_allocation.h"
+#include "../allocator/allocator_sorted_list.h"
+#include "../allocator/allocator_tlsf.h"
+#include "../allocator/thread_caching_allocator.h"
+#include "../allocator/sharded_allocator.h"
+
+// Multithreaded churn throughput for 1..N threads. Every thread replays its own random allocate/deallocate
+// sequence against:
+//   - a shared heap wrapped into a global std::mutex (the old way of calling engines from several threads);
+//   - a shared heap relying on the engine's own spinlock;
+//   - a heap per thread, so the engine's lock is never contended;
+//   - a shared heap behind thread_caching_allocator;
+//   - sharded_allocator with a heap per cpu.
+
+namespace
+{
+
+    size_t const trusted_memory_size = 64 * 1024 * 1024;
+    size_t const live_blocks_limit = 1024;
+    size_t const operations_per_thread_count = 200000;
+
+    class mutex_guarded_allocator final:
+        public allocator
+    {
+
+    private:
+
+        allocator *_allocator;
+        std::mutex _mutex;
+
+    public:
+
+        explicit mutex_guarded_allocator(
+            allocator *guarded_allocator):
+            _allocator(guarded_allocator)
+        {
+
+        }
+
+    public:
+
+        void *allocate(
+            size_t requested_block_size) override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _allocator->allocate(requested_block_size);
+        }
+
+        void deallocate(
+            void *block_to_deallocate_address) override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _allocator->deallocate(block_to_deallocate_address);
+        }
+
+        void *reallocate(
+            void *block_to_reallocate_address,
+            size_t new_block_size) override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _allocator->reallocate(block_to_reallocate_address, new_block_size);
+        }
+
+        bool reallocate(
+            void **block_to_reallocate_address_address,
+            size_t new_block_size) override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _allocator->reallocate(block_to_reallocate_address_address, new_block_size);
+        }
+
+        void *allocate_aligned(
+            size_t requested_block_size,
+            size_t alignment) override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _allocator->allocate_aligned(requested_block_size, alignment);
+        }
+
+    };
+
+    void churn(
+        allocator *allocator_to_benchmark,
+        size_t seed)
+    {
+        std::mt19937_64 engine(seed);
+        std::vector<void *> live_blocks;
+        live_blocks.reserve(live_blocks_limit);
+
+        for (size_t i = 0; i < operations_per_thread_count; i++)
+        {
+            if (live_blocks.empty() || (live_blocks.size() < live_blocks_limit && engine() % 2 == 0))
+            {
+                try
+                {
+                    live_blocks.push_back(allocator_to_benchmark->allocate(16 + engine() % 496));
+                }
+                catch (allocator::memory_exception const &)
+                {
+
+                }
+            }
+            else
+            {
+                auto const index = engine() % live_blocks.size();
+                allocator_to_benchmark->deallocate(live_blocks[index]);
+                live_blocks[index] = live_blocks.back();
+                live_blocks.pop_back();
+            }
+        }
+
+        for (auto *block : live_blocks)
+        {
+            allocator_to_benchmark->deallocate(block);
+        }
+    }
+
+    // allocator_for_thread(i) returns the heap used by i-th thread
+    double run(
+        size_t threads_count,
+        std::function<allocator *(size_t)> const &allocator_for_thread)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(threads_count);
+
+        // threads wait at the start barrier, so their creation is kept out of the measured time
+        std::atomic<size_t> ready_threads_count(0);
+        std::atomic<bool> is_started(false);
+
+        for (size_t i = 0; i < threads_count; i++)
+        {
+            threads.emplace_back([&ready_threads_count, &is_started](allocator *allocator_to_benchmark, size_t seed)
+            {
+                ready_threads_count.fetch_add(1, std::memory_order_acq_rel);
+                while (!is_started.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+
+                churn(allocator_to_benchmark, seed);
+            }, allocator_for_thread(i), 20240619 + i);
+        }
+
+        while (ready_threads_count.load(std::memory_order_acquire) != threads_count)
+        {
+            std::this_thread::yield();
+        }
+
+        auto const started_at = std::chrono::steady_clock::now();
+        is_started.store(true, std::memory_order_release);
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        auto const finished_at = std::chrono::steady_clock::now();
+        auto const seconds = std::chrono::duration<double>(finished_at - started_at).count();
+
+        return static_cast<double>(threads_count * operations_per_thread_count) / seconds / 1e6;
+    }
+
+    template<
+        typename engine_type>
+    void run_engine(
+        std::string const &name,
+        size_t max_threads_count)
+    {
+        auto const mode = allocator_fit_allocation::allocation_mode::the_best_fit;
+
+        std::cout << name << " [Mops/s]" << std::endl
+                  << std::left << std::setw(10) << "threads"
+                  << std::setw(16) << "global mutex"
+                  << std::setw(16) << "engine lock"
+                  << std::setw(16) << "heap per thread"
+                  << std::setw(16) << "thread cache"
+                  << std::setw(16) << "cpu shards" << std::endl;
+
+        // powers of 2 are swept up to max threads count, which is measured itself even if it isn't a power of 2
+        for (size_t threads_count = 1;; threads_count = std::min(threads_count << 1, max_threads_count))
+        {
+            engine_type shared_engine(trusted_memory_size, nullptr, nullptr, mode);
+            mutex_guarded_allocator guarded_engine(&shared_engine);
+            thread_caching_allocator cached_engine(&shared_engine);
+            sharded_allocator sharded_engine(max_threads_count, trusted_memory_size / max_threads_count, &sharded_allocator::create_shard<engine_type>);
+
+            std::vector<std::unique_ptr<engine_type>> engines;
+            for (size_t i = 0; i < threads_count; i++)
+            {
+                engines.push_back(std::make_unique<engine_type>(trusted_memory_size / threads_count, nullptr, nullptr, mode));
+            }
+
+            auto const global_mutex_throughput = run(threads_count, [&guarded_engine](size_t) -> allocator * { return &guarded_engine; });
+            auto const engine_lock_throughput = run(threads_count, [&shared_engine](size_t) -> allocator * { return &shared_engine; });
+            auto const heap_per_thread_throughput = run(threads_count, [&engines](size_t i) -> allocator * { return engines[i].get(); });
+            auto const thread_cache_throughput = run(threads_count, [&cached_engine](size_t) -> allocator * { return &cached_engine; });
+            auto const cpu_shards_throughput = run(threads_count, [&sharded_engine](size_t) -> allocator * { return &sharded_engine; });
+
+            std::cout << std::fixed << std::setprecision(2) << std::left
+                      << std::setw(10) << threads_count
+                      << std::setw(16) << global_mutex_throughput
+                      << std::setw(16) << engine_lock_throughput
+                      << std::setw(16) << heap_per_thread_throughput
+                      << std::setw(16) << thread_cache_throughput
+                      << std::setw(16) << cpu_shards_throughput << std::endl;
+
+            if (threads_count == max_threads_count)
+            {
+                break;
+            }
+        }
+
+        std::cout << std::endl;
+    }
+
+}
+
+int main()
+{
+    auto const max_threads_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    run_engine<allocator_sorted_list>("allocator_sorted_list", max_threads_count);
+    run_engine<allocator_tlsf>("allocator_tlsf", max_threads_count);
+
+    return 0;
+}